@@ -37,6 +37,7 @@ extern "C" {
 
 #define HP_MAX_LEVELS	4		/* 128^5 records is enough */
 #define HP_PTRS_IN_NOD	128
+#define HP_BLOB_CHUNK_SIZE 128		/* Size of a block of blob data */
 
 	/* struct used with heap_funktions */
 
@@ -109,12 +110,26 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For referense */
 
+/*
+  BLOB columns. The data of a blob is stored in a chain of blocks of
+  HP_BLOB_CHUNK_SIZE bytes in HP_SHARE::blob_block. Each block starts
+  with a pointer to the next block of the chain. In the stored record
+  the pointer part of the blob column points to the first block.
+*/
+
+typedef struct st_hp_blob_desc
+{
+  uint offset;				/* Offset of the column in the record */
+  uint packlength;			/* Length of the length part (1-4) */
+} HP_BLOB_DESC;
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
   uint keysegs;				/* Number of key-segment */
   uint length;				/* Length of key (automatic) */
   uint8 algorithm;			/* HASH / BTREE */
+  my_bool binary_hash;			/* Key is hashed with my_crc32c() */
   HA_KEYSEG *seg;
   HP_BLOCK block;			/* Where keys are saved */
   /*
@@ -133,7 +148,9 @@ typedef struct st_hp_keydef		/* Key definition with open */
 typedef struct st_heap_share
 {
   HP_BLOCK block;
+  HP_BLOCK blob_block;			/* Where blob data is saved */
   HP_KEYDEF  *keydef;
+  HP_BLOB_DESC *blob_descs;
   ulonglong data_length,index_length,max_table_size;
   ulonglong auto_increment;
   ulong min_records,max_records;	/* Params to open */
@@ -147,9 +164,12 @@ typedef struct st_heap_share
   uint visible;                         /* Offset to the visible/deleted mark */
   uint changed;
   uint keys,max_key_length;
+  uint blobs;				/* Number of blob columns */
   uint currently_disabled_keys;    /* saved value from "keys" when disabled */
   uint open_count;
   uchar *del_link;			/* Link to next block with del. rec */
+  uchar *blob_del_link;			/* Link to next free blob block */
+  ulong blob_chunks;			/* Allocated blocks in blob_block */
   char * name;			/* Name of "memory-file" */
   time_t create_time;
   THR_LOCK lock;
@@ -173,6 +193,9 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar **blob_chains;                   /* New blob chains of a write */
+  uchar *blob_buff;                      /* Blobs of the last read record */
+  size_t blob_buff_length;
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -188,9 +211,11 @@ typedef struct st_heap_info
 typedef struct st_heap_create_info
 {
   HP_KEYDEF *keydef;
+  HP_BLOB_DESC *blob_descs;
   uint auto_key;                        /* keynr [1 - maxkey] for auto key */
   uint auto_key_type;
   uint keys;
+  uint blobs;
   uint reclength;
   ulong max_records;
   ulong min_records;
@@ -652,6 +652,8 @@ void	net_clear(NET *net, my_bool clear_buffer);
 my_bool net_realloc(NET *net, size_t length);
 my_bool	net_flush(NET *net);
 my_bool	my_net_write(NET *net,const unsigned char *packet, size_t len);
+my_bool	my_net_write_parts(NET *net, const unsigned char **parts,
+                           const size_t *lengths, unsigned int n_parts);
 my_bool	net_write_command(NET *net,unsigned char command,
 			  const unsigned char *header, size_t head_len,
 			  const unsigned char *packet, size_t len);
@@ -0,0 +1,271 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_class.h"
+#include "item_cmpfunc.h"
+#include "cond_filter.h"
+#include <algorithm>
+
+
+inline longlong Cond_filter::term_t::value() const
+{
+  const uchar *ptr= field->ptr;
+  switch (length) {
+  case 1:
+    return is_unsigned ? (longlong) ptr[0] : (longlong) (signed char) ptr[0];
+  case 2:
+    return is_unsigned ? (longlong) uint2korr(ptr) : (longlong) sint2korr(ptr);
+  case 3:
+    return is_unsigned ? (longlong) uint3korr(ptr) : (longlong) sint3korr(ptr);
+  case 4:
+    return is_unsigned ? (longlong) uint4korr(ptr) : (longlong) sint4korr(ptr);
+  }
+  DBUG_ASSERT(length == 8);
+  DBUG_ASSERT(!is_unsigned);
+  return sint8korr(ptr);
+}
+
+
+inline bool Cond_filter::term_t::eval() const
+{
+  /* For any op, a NULL value makes the predicate UNKNOWN, that is, false */
+  if (field->is_null())
+    return false;
+
+  if (op == OP_NOT_NULL)
+    return true;
+
+  const longlong v= value();
+  switch (op) {
+  case OP_EQ:          return v == a;
+  case OP_NE:          return v != a;
+  case OP_LT:          return v < a;
+  case OP_LE:          return v <= a;
+  case OP_GT:          return v > a;
+  case OP_GE:          return v >= a;
+  case OP_BETWEEN:     return v >= a && v <= b;
+  case OP_NOT_BETWEEN: return v < a || v > b;
+  case OP_IN:          return std::binary_search(list, list + n_list, v);
+  case OP_NOT_IN:      return !std::binary_search(list, list + n_list, v);
+  case OP_NOT_NULL:    break;
+  }
+  DBUG_ASSERT(0);
+  return false;
+}
+
+
+bool Cond_filter::eval() const
+{
+  for (const term_t *t= m_terms, *end= m_terms + m_n_terms; t != end; t++)
+    if (!t->eval())
+      return false;
+  return true;
+}
+
+
+/*
+  @return the field of an integer column that Cond_filter can read
+  @retval NULL if item is not such a column
+*/
+
+static Field *int_field(Item *item)
+{
+  if (item->type() != Item::FIELD_ITEM)
+    return NULL;
+  Field *field= static_cast<Item_field*>(item)->field;
+  switch (field->real_type()) {
+  case MYSQL_TYPE_TINY:
+  case MYSQL_TYPE_SHORT:
+  case MYSQL_TYPE_INT24:
+  case MYSQL_TYPE_LONG:
+    break;
+  case MYSQL_TYPE_LONGLONG:
+    /* Values above LONGLONG_MAX do not fit in the terms */
+    if (field->flags & UNSIGNED_FLAG)
+      return NULL;
+    break;
+  default:
+    return NULL;
+  }
+  if (field->type() != field->real_type() ||
+      field->cmp_type() != INT_RESULT)
+    return NULL;
+  return field;
+}
+
+
+/*
+  Evaluate an integer constant.
+
+  @param item   the constant
+  @param value  the value
+
+  @return whether item is a non-NULL integer constant that fits in longlong
+*/
+
+static bool int_const(Item *item, longlong *value)
+{
+  if (item->type() != Item::CONST_ITEM || item->cmp_type() != INT_RESULT)
+    return false;
+  *value= item->val_int();
+  return !item->null_value && (!item->unsigned_flag || *value >= 0);
+}
+
+
+bool Cond_filter::add_func(Item *item)
+{
+  Item_func *func= static_cast<Item_func*>(item);
+  Item **args= func->arguments();
+  term_t t;
+  t.list= NULL;
+  t.n_list= 0;
+  t.b= 0;
+
+  switch (func->functype()) {
+  case Item_func::ISNOTNULL_FUNC:
+    if (args[0]->type() != Item::FIELD_ITEM)
+      return true;
+    t.field= static_cast<Item_field*>(args[0])->field;
+    t.op= OP_NOT_NULL;
+    t.length= 0;
+    t.is_unsigned= false;
+    t.a= 0;
+    goto add;
+  case Item_func::EQ_FUNC:  t.op= OP_EQ; break;
+  case Item_func::NE_FUNC:  t.op= OP_NE; break;
+  case Item_func::LT_FUNC:  t.op= OP_LT; break;
+  case Item_func::LE_FUNC:  t.op= OP_LE; break;
+  case Item_func::GT_FUNC:  t.op= OP_GT; break;
+  case Item_func::GE_FUNC:  t.op= OP_GE; break;
+  case Item_func::BETWEEN:
+    if (!(t.field= int_field(args[0])) ||
+        !int_const(args[1], &t.a) || !int_const(args[2], &t.b))
+      return true;
+    t.op= static_cast<Item_func_between*>(func)->negated
+      ? OP_NOT_BETWEEN : OP_BETWEEN;
+    goto add_field;
+  case Item_func::IN_FUNC:
+  {
+    if (!(t.field= int_field(args[0])))
+      return true;
+    const uint n= func->argument_count() - 1;
+    longlong *list= m_values;
+    for (uint i= 0; i < n; i++)
+    {
+      longlong value;
+      if (!int_const(args[i + 1], &value))
+        return true;
+      if (list)
+        list[i]= value;
+    }
+    if (list)
+    {
+      std::sort(list, list + n);
+      m_values+= n;
+    }
+    m_n_values+= n;
+    t.list= list;
+    t.n_list= n;
+    t.op= static_cast<Item_func_in*>(func)->negated ? OP_NOT_IN : OP_IN;
+    t.a= 0;
+    goto add_field;
+  }
+  default:
+    return true;
+  }
+
+  /* A comparison: int_col OP const, or const OP int_col */
+  DBUG_ASSERT(func->argument_count() == 2);
+  if ((t.field= int_field(args[0])))
+  {
+    if (!int_const(args[1], &t.a))
+      return true;
+  }
+  else if ((t.field= int_field(args[1])) && int_const(args[0], &t.a))
+  {
+    switch (t.op) {
+    case OP_LT: t.op= OP_GT; break;
+    case OP_LE: t.op= OP_GE; break;
+    case OP_GT: t.op= OP_LT; break;
+    case OP_GE: t.op= OP_LE; break;
+    default: break;
+    }
+  }
+  else
+    return true;
+
+add_field:
+  t.length= static_cast<uint8>(t.field->pack_length());
+  t.is_unsigned= t.field->flags & UNSIGNED_FLAG;
+add:
+  if (m_n_terms == MAX_TERMS)
+    return true;
+  m_terms[m_n_terms++]= t;
+  return false;
+}
+
+
+/*
+  Add the predicates of a condition.
+
+  @return whether the condition cannot be compiled
+*/
+
+bool Cond_filter::add(Item *cond)
+{
+  if (cond->type() == Item::COND_ITEM &&
+      static_cast<Item_cond*>(cond)->functype() == Item_func::COND_AND_FUNC)
+  {
+    List_iterator_fast<Item> it(*static_cast<Item_cond*>(cond)->
+                                argument_list());
+    while (Item *item= it++)
+      if (add(item))
+        return true;
+    return false;
+  }
+
+  return cond->type() != Item::FUNC_ITEM || add_func(cond);
+}
+
+
+Cond_filter *Cond_filter::create(THD *thd, Item *cond)
+{
+  /*
+    Most conditions cannot be compiled. Check that this one can before
+    anything is allocated on thd->mem_root, which lives until the end of
+    the statement.
+  */
+  Cond_filter filter;
+  if (filter.add(cond) || !filter.m_n_terms)
+    return NULL;
+
+  if (filter.m_n_values)
+  {
+    /* Add the terms again, and store the IN lists this time */
+    if (!(filter.m_values= static_cast<longlong*>
+          (thd->alloc(filter.m_n_values * sizeof *filter.m_values))))
+      return NULL;
+    filter.m_n_terms= 0;
+    if (filter.add(cond))
+    {
+      DBUG_ASSERT(0);
+      return NULL;
+    }
+  }
+
+  return new (thd->mem_root) Cond_filter(filter);
+}
@@ -0,0 +1,113 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef COND_FILTER_INCLUDED
+#define COND_FILTER_INCLUDED
+
+#include "mariadb.h"
+#include "sql_alloc.h"
+
+class THD;
+class Item;
+class Field;
+
+/*
+  Compiled form of a simple condition attached to a join table
+
+  evaluate_join_record() calls select_cond->val_int() for every row it
+  reads. This walks the Item tree: a virtual call for each AND, each
+  comparison, each argument and each Arg_comparator.
+
+  A very common condition in a scan is a conjunction of predicates
+  like
+
+    int_col {=|<>|<|<=|>|>=} int_const
+    int_col [NOT] BETWEEN int_const AND int_const
+    int_col [NOT] IN (int_const, ...)
+    col IS NOT NULL
+
+  Cond_filter::create() flattens such a condition into an array of terms.
+  Each term reads the integer directly from the record buffer of its
+  field. Cond_filter::eval() then gives the same result as
+  select_cond->val_int() in one non-virtual loop.
+
+  Conditions that contain anything else are not compiled. This includes
+  BIGINT UNSIGNED columns, non-integer constants, functions and
+  subqueries. The caller keeps using Item::val_int() for them.
+*/
+
+class Cond_filter : public Sql_alloc
+{
+public:
+  /* Maximum number of predicates in a compiled condition */
+  static const uint MAX_TERMS= 16;
+
+  /*
+    Compile a condition.
+
+    @param thd   thread handle; a filter that could be compiled is
+                 allocated on thd->mem_root
+    @param cond  the condition
+
+    @return the filter
+    @retval NULL if the condition cannot be compiled
+  */
+  static Cond_filter *create(THD *thd, Item *cond);
+
+  /* Evaluate the condition on the current contents of the record buffers */
+  bool eval() const;
+
+private:
+  enum op_t
+  {
+    OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE,
+    OP_BETWEEN, OP_NOT_BETWEEN, OP_IN, OP_NOT_IN, OP_NOT_NULL
+  };
+
+  /* A predicate on a column */
+  struct term_t
+  {
+    Field *field;
+    op_t op;
+    /* pack_length() of the integer column, or 0 for OP_NOT_NULL */
+    uint8 length;
+    bool is_unsigned;
+    /* the constant, or the lower bound for OP_BETWEEN */
+    longlong a;
+    /* the upper bound for OP_BETWEEN */
+    longlong b;
+    /* the sorted IN list and its size */
+    const longlong *list;
+    uint n_list;
+
+    inline longlong value() const;
+    inline bool eval() const;
+  };
+
+  Cond_filter() : m_n_terms(0), m_n_values(0), m_values(NULL) {}
+
+  bool add(Item *cond);
+  bool add_func(Item *func);
+
+  term_t m_terms[MAX_TERMS];
+  uint m_n_terms;
+  /* total size of the IN lists */
+  uint m_n_values;
+  /* where add_func() stores the next IN list, or NULL to only check it */
+  longlong *m_values;
+};
+
+#endif /* COND_FILTER_INCLUDED */
@@ -19,6 +19,12 @@
 #include "sql_const.h"
 #include "sql_sort.h"
 #include "table.h"
+#include "sql_class.h"
+#include "sql_parallel.h"
+#include "debug_sync.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
@@ -159,30 +165,323 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/** Tasks of run_sort_tasks() that are claimed by number */
+template<typename Task>
+struct Sort_tasks
+{
+  const Task &task;
+  const uint n_tasks;
+  /* the next task to claim */
+  std::atomic<uint> next;
+  /* whether the sort was killed */
+  std::atomic<bool> killed;
+
+  Sort_tasks(const Task &task, uint n_tasks) :
+    task(task), n_tasks(n_tasks), next(0), killed(false) {}
+
+  /* Claim and execute tasks until there are none left */
+  void run()
+  {
+    uint i;
+    while (!killed.load(std::memory_order_relaxed) &&
+           (i= next.fetch_add(1, std::memory_order_relaxed)) < n_tasks)
+      task(i);
+  }
+
+  static void run_callback(void *arg)
+  { static_cast<Sort_tasks*>(arg)->run(); }
+};
+
+
+/**
+  Run tasks in the calling thread and in Parallel_tasks.
+
+  @param thd      thread handle
+  @param n_tasks  number of tasks
+  @param task     function that executes the task with the given number
+
+  The calling thread claims tasks as well, so that all tasks are executed
+  even if the pool threads are busy with other statements. The calling
+  thread checks for KILL before each task that it claims.
+
+  @retval false  if all tasks were executed
+  @retval true   if the statement was killed
+*/
+
+template<typename Task>
+static bool run_sort_tasks(THD *thd, uint n_tasks, const Task &task)
+{
+  Sort_tasks<Task> tasks(task, n_tasks);
+  Parallel_tasks workers(Sort_tasks<Task>::run_callback, &tasks);
+  workers.submit(n_tasks - 1);
+
+  uint i;
+  while (!tasks.killed.load(std::memory_order_relaxed) &&
+         (i= tasks.next.fetch_add(1, std::memory_order_relaxed)) < n_tasks)
+  {
+    DEBUG_SYNC(thd, "parallel_sort_task");
+    if (thd->check_killed())
+      tasks.killed= true;
+    else
+      task(i);
+  }
+
+  workers.wait();
+  return tasks.killed;
+}
+
+
+/** Buckets of fewer keys are sorted by comparison in msd_radix_sort() */
+static const size_t MSD_RADIX_MIN_KEYS= 64;
+/** Minimum number of keys for which sort_keys() uses msd_radix_sort() */
+static const uint MSD_RADIX_MIN_SORT= 1000;
+/** Beyond this depth, msd_radix_sort() sorts buckets by comparison */
+static const size_t MSD_RADIX_MAX_DEPTH= 64;
+
+
+/**
+  Distribute keys into buckets by the byte at an offset.
+
+  @param keys    key pointers
+  @param count   number of keys
+  @param depth   offset of the byte
+  @param buffer  scratch space for count key pointers
+
+  @return whether all keys have the same byte at depth
+
+  This is not inlined, so that the recursion of msd_radix_sort() does not
+  keep the counters on the stack.
+*/
+
+ATTRIBUTE_NOINLINE
+static bool msd_radix_pass(uchar **keys, size_t count, size_t depth,
+                           uchar **buffer)
+{
+  size_t offsets[256]= {0};
+  for (size_t i= 0; i < count; i++)
+    offsets[keys[i][depth]]++;
+
+  size_t sum= 0;
+  for (size_t b= 0; b < 256; b++)
+  {
+    if (offsets[b] == count)
+      return true;
+    const size_t n= offsets[b];
+    offsets[b]= sum;
+    sum+= n;
+  }
+
+  for (size_t i= 0; i < count; i++)
+    buffer[offsets[keys[i][depth]]++]= keys[i];
+  memcpy(keys, buffer, count * sizeof *keys);
+  return false;
+}
+
+
+/**
+  Most significant digit first radix sort of memcmp() comparable keys.
+
+  @param keys    key pointers
+  @param count   number of keys
+  @param length  length of a key, in bytes
+  @param depth   number of leading bytes that are equal in all the keys
+  @param buffer  scratch space for count key pointers
+*/
+
+static void msd_radix_sort(uchar **keys, size_t count, size_t length,
+                           size_t depth, uchar **buffer)
+{
+  for (; depth < length; depth++)
+  {
+    const size_t len= length - depth;
+    if (count < MSD_RADIX_MIN_KEYS)
+    {
+      /* Insertion sort, which is stable like the radix passes */
+      for (size_t i= 1; i < count; i++)
+      {
+        uchar *key= keys[i];
+        size_t j= i;
+        for (; j && memcmp(keys[j - 1] + depth, key + depth, len) > 0; j--)
+          keys[j]= keys[j - 1];
+        keys[j]= key;
+      }
+      return;
+    }
+    if (depth >= MSD_RADIX_MAX_DEPTH)
+    {
+      std::stable_sort(keys, keys + count, [depth, len](uchar *a, uchar *b) {
+        return memcmp(a + depth, b + depth, len) < 0;
+      });
+      return;
+    }
+
+    if (msd_radix_pass(keys, count, depth, buffer))
+      continue;
+
+    /* Sort each bucket by the remaining bytes. */
+    for (size_t start= 0; start < count; )
+    {
+      const uchar byte= keys[start][depth];
+      size_t end= start + 1;
+      while (end < count && keys[end][depth] == byte)
+        end++;
+      if (end - start > 1)
+        msd_radix_sort(keys + start, end - start, length, depth + 1,
+                       buffer + start);
+      start= end;
+    }
+    return;
+  }
+}
+
+
+/**
+  Sort an array of key pointers in the calling thread.
+
+  The sort keys that make_sortkey() produces are compared with memcmp(),
+  unless they are packed. Short keys are sorted with the least significant
+  digit first radix sort of mysys, and other memcmp() comparable keys with
+  msd_radix_sort().
+
+  @param keys    key pointers
+  @param count   number of keys
+  @param param   sort parameters
+  @param size    sort_length, for the comparison function
+  @param buffer  scratch space for count key pointers, or NULL
+*/
+
+static void sort_keys(uchar **keys, uint count, const Sort_param *param,
+                      size_t *size, uchar **buffer)
+{
+  if (buffer && !param->using_packed_sortkeys())
+  {
+    if (radixsort_is_appliccable(count, *size))
+    {
+      radixsort_for_str_ptr(keys, count, *size, buffer);
+      return;
+    }
+    if (count >= MSD_RADIX_MIN_SORT)
+    {
+      msd_radix_sort(keys, count, *size, 0, buffer);
+      return;
+    }
+  }
+
+  my_qsort2(keys, count, sizeof(uchar*),
+            param->get_compare_function(),
+            param->get_compare_argument(size));
+}
+
+
+/**
+  Sort an array of key pointers with several threads.
+
+  The array is split into one chunk per thread, and each thread sorts its
+  chunk with sort_keys(). Then the sorted chunks are merged pairwise,
+  alternating between the array and the buffer. The merges of each round
+  run in parallel.
+
+  @param keys      key pointers
+  @param count     number of keys
+  @param n_threads maximum number of threads
+  @param param     sort parameters
+  @param size      sort_length, for the comparison function
+  @param buffer    scratch space for count key pointers
+  @param killed    set if the statement was killed
+
+  @retval false  if the keys were sorted, or the statement was killed
+  @retval true   if there is not enough work for parallel sorting
+*/
+
+static bool parallel_sort(uchar **keys, uint count, uint n_threads,
+                          const Sort_param *param, size_t *size,
+                          uchar **buffer, bool *killed)
+{
+  /* Do not bother using threads for sorting fewer keys */
+  const uint MIN_KEYS_PER_THREAD= 32768;
+  n_threads= MY_MIN(n_threads, count / MIN_KEYS_PER_THREAD);
+  if (n_threads < 2)
+    return true;
+
+  THD *const thd= current_thd;
+
+  /* Run boundaries: run i is [bounds[i], bounds[i + 1]) */
+  std::vector<uint> bounds(n_threads + 1);
+  for (uint i= 0; i <= n_threads; i++)
+    bounds[i]= (uint) ((ulonglong) count * i / n_threads);
+
+  if ((*killed= run_sort_tasks(thd, n_threads, [&](uint i) {
+         sort_keys(keys + bounds[i], bounds[i + 1] - bounds[i], param, size,
+                   buffer + bounds[i]);
+       })))
+    return false;
+
+  const qsort2_cmp cmp= param->get_compare_function();
+  void *const cmp_arg= param->get_compare_argument(size);
+  const auto less= [cmp, cmp_arg](uchar *a, uchar *b) {
+    return cmp(cmp_arg, &a, &b) < 0;
+  };
+  uchar **from= keys, **to= buffer;
+
+  while (bounds.size() > 2)
+  {
+    const uint n_runs= (uint) bounds.size() - 1;
+    if ((*killed= run_sort_tasks(thd, (n_runs + 1) / 2, [&](uint i) {
+      const uint start= bounds[2 * i];
+      const uint end= bounds[MY_MIN(2 * i + 2, n_runs)];
+      if (2 * i + 1 < n_runs)
+      {
+        const uint middle= bounds[2 * i + 1];
+        std::merge(from + start, from + middle, from + middle, from + end,
+                   to + start, less);
+      }
+      else
+        memcpy(to + start, from + start, (end - start) * sizeof(uchar*));
+    })))
+      return false;
+
+    std::vector<uint> merged;
+    for (uint i= 0; i < n_runs; i+= 2)
+      merged.push_back(bounds[i]);
+    merged.push_back(count);
+    bounds.swap(merged);
+    std::swap(from, to);
+  }
+
+  if (from != keys)
+    memcpy(keys, from, count * sizeof(uchar*));
+  return false;
+}
+
+
+bool Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
+  bool killed= false;
   m_sort_keys= get_sort_keys();
 
   if (count <= 1 || size == 0)
-    return;
+    return false;
 
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
     reverse_record_pointers();
 
+  /*
+    Radix sort and parallel sort need a second array of key pointers.
+    If it cannot be allocated, fall back to my_qsort2().
+  */
   uchar **buffer= NULL;
-  if (!param->using_packed_sortkeys() &&
-      radixsort_is_appliccable(count, param->sort_length) &&
-      (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
-                                   MYF(MY_THREAD_SPECIFIC))))
-  {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
-    my_free(buffer);
-    return;
-  }
+  if ((param->sort_threads > 1 || !param->using_packed_sortkeys()) &&
+      count >= MSD_RADIX_MIN_SORT)
+    buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count * sizeof(uchar*),
+                                MYF(MY_THREAD_SPECIFIC));
 
-  my_qsort2(m_sort_keys, count, sizeof(uchar*),
-            param->get_compare_function(),
-            param->get_compare_argument(&size));
+  if (!buffer || param->sort_threads <= 1 ||
+      parallel_sort(m_sort_keys, count, param->sort_threads, param, &size,
+                    buffer, &killed))
+    sort_keys(m_sort_keys, count, param, &size, buffer);
+
+  my_free(buffer);
+  return killed;
 }
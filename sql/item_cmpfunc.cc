@@ -3656,12 +3656,58 @@ static int cmp_decimal(void *cmp_arg, my_decimal *a, my_decimal *b)
 }
 
 
+/*
+  Create a hash table over the sorted elements
+
+  DESCRIPTION
+    The table uses open addressing with linear probing and is at most
+    half full, so that find() needs O(1) comparisons instead of
+    O(log(used_count)) for bisection. Duplicate elements are added only
+    once.
+
+  RETURN VALUE
+    FALSE       ok
+    TRUE        out of memory
+*/
+
+bool in_vector::create_hash(THD *thd)
+{
+  uint buckets= my_round_up_to_next_power(used_count * 2);
+  if (!(hash_table= (uint*) thd_calloc(thd, buckets * sizeof(uint))))
+    return true;
+  hash_mask= buckets - 1;
+  for (uint i= 0; i < used_count; i++)
+  {
+    const uchar *elem= (uchar*) base + i * size;
+    if (i && !(*compare)(collation, elem - size, elem))
+      continue;
+    uint pos= (uint) hash_value(elem) & hash_mask;
+    while (hash_table[pos])
+      pos= (pos + 1) & hash_mask;
+    hash_table[pos]= i + 1;
+  }
+  return false;
+}
+
+
 bool in_vector::find(Item *item)
 {
   uchar *result=get_value(item);
   if (!result || !used_count)
     return false;				// Null value
 
+  if (hash_table)
+  {
+    for (uint pos= (uint) hash_value(result) & hash_mask; hash_table[pos];
+         pos= (pos + 1) & hash_mask)
+    {
+      if ((*compare)(collation, base + (hash_table[pos] - 1) * size,
+                     result) == 0)
+        return true;
+    }
+    return false;
+  }
+
   uint start,end;
   start=0; end=used_count-1;
   while (start != end)
@@ -3727,6 +3773,15 @@ Item *in_string::create_item(THD *thd)
   return new (thd->mem_root) Item_string_for_in_vector(thd, collation);
 }
 
+ulong in_string::hash_value(const uchar *elem) const
+{
+  const String *str= (const String*) elem;
+  ulong nr1= 1, nr2= 4;
+  my_ci_hash_sort(collation, (const uchar*) str->ptr(), str->length(),
+                  &nr1, &nr2);
+  return nr1;
+}
+
 
 in_row::in_row(THD *thd, uint elements, Item * item)
 {
@@ -3794,6 +3849,24 @@ Item *in_longlong::create_item(THD *thd)
   return new (thd->mem_root) Item_int(thd, (longlong)0);
 }
 
+/*
+  Equal values have the same bits in val, also if only one of them is
+  unsigned (see cmp_longlong()). The bits are mixed as in the
+  MurmurHash3 finalizer, so that the low bits used for the bucket
+  depend on all of them.
+*/
+
+ulong in_longlong::hash_value(const uchar *elem) const
+{
+  ulonglong nr= (ulonglong) ((const packed_longlong*) elem)->val;
+  nr^= nr >> 33;
+  nr*= 0xff51afd7ed558ccdULL;
+  nr^= nr >> 33;
+  nr*= 0xc4ceb9fe1a85ec53ULL;
+  nr^= nr >> 33;
+  return (ulong) nr;
+}
+
 
 static int cmp_timestamp(void *cmp_arg,
                          Timestamp_or_zero_datetime *a,
@@ -4499,6 +4572,7 @@ bool Item_func_in::fix_length_and_dec(THD *thd)
 
 /**
   Populate Item_func_in::array with constant not-NULL arguments and sort them.
+  Long lists also get a hash table for the lookups.
 
   Sets "have_null" to true if some of the values appeared to be NULL.
   Note, explicit NULLs were found during prepare_predicant_and_values().
@@ -4524,7 +4598,12 @@ void Item_func_in::fix_in_vector()
     }
   }
   if ((array->used_count= j))
+  {
     array->sort();
+    if (array->used_count >= IN_VECTOR_HASH_MIN_ELEMENTS &&
+        array->hashable())
+      array->create_hash(current_thd);
+  }
 }
 
 
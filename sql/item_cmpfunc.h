@@ -1439,6 +1439,12 @@ class Item_func_nullif :public Item_func_case_expression
 
 /* A vector of values of some type  */
 
+/*
+  IN lists with at least this many values are searched through a hash
+  table instead of with bisection, see in_vector::create_hash()
+*/
+#define IN_VECTOR_HASH_MIN_ELEMENTS 64
+
 class in_vector :public Sql_alloc
 {
 public:
@@ -1448,12 +1454,14 @@ class in_vector :public Sql_alloc
   CHARSET_INFO *collation;
   uint count;
   uint used_count;
-  in_vector() {}
+  uint *hash_table;                     // Element position + 1, 0 if free
+  uint hash_mask;
+  in_vector() :hash_table(0) {}
   in_vector(THD *thd, uint elements, uint element_length, qsort2_cmp cmp_func,
   	    CHARSET_INFO *cmp_coll)
     :base((char*) thd_calloc(thd, elements * element_length)),
      size(element_length), compare(cmp_func), collation(cmp_coll),
-     count(elements), used_count(elements) {}
+     count(elements), used_count(elements), hash_table(0) {}
   virtual ~in_vector() {}
   virtual void set(uint pos,Item *item)=0;
   virtual uchar *get_value(Item *item)=0;
@@ -1461,7 +1469,14 @@ class in_vector :public Sql_alloc
   {
     my_qsort2(base,used_count,size,compare,(void*)collation);
   }
+  bool create_hash(THD *thd);
   bool find(Item *item);
+  /*
+    Hash value of an element, used if hashable() is true.
+    Elements that compare() finds equal must have the same hash value.
+  */
+  virtual bool hashable() const { return false; }
+  virtual ulong hash_value(const uchar *elem) const { return 0; }
   
   /* 
     Create an instance of Item_{type} (e.g. Item_decimal) constant object
@@ -1519,6 +1534,8 @@ class in_string :public in_vector
     Item_string_for_in_vector *to= (Item_string_for_in_vector*) item;
     to->set_value(str);
   }
+  bool hashable() const override { return true; }
+  ulong hash_value(const uchar *elem) const override;
   const Type_handler *type_handler() const override
   { return &type_handler_varchar; }
 };
@@ -1547,6 +1564,8 @@ class in_longlong :public in_vector
     ((Item_int*) item)->unsigned_flag= (bool)
       ((packed_longlong*) base)[pos].unsigned_flag;
   }
+  bool hashable() const override { return true; }
+  ulong hash_value(const uchar *elem) const override;
   const Type_handler *type_handler() const override
   { return &type_handler_slonglong; }
 
@@ -107,6 +107,7 @@ static const LEX_CSTRING write_error_msg=
     { STRING_WITH_LEN("error writing to the binary log") };
 
 static my_bool opt_optimize_thread_scheduling= TRUE;
+static my_bool opt_binlog_sync_pipeline= FALSE;
 ulong binlog_checksum_options;
 #ifndef DBUG_OFF
 ulong opt_binlog_dbug_fsync_sleep= 0;
@@ -114,6 +115,7 @@ ulong opt_binlog_dbug_fsync_sleep= 0;
 
 mysql_mutex_t LOCK_prepare_ordered;
 mysql_cond_t COND_prepare_ordered;
+mysql_mutex_t LOCK_binlog_sync;
 mysql_mutex_t LOCK_after_binlog_sync;
 mysql_mutex_t LOCK_commit_ordered;
 
@@ -4475,6 +4477,7 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool create_new_log,
       later would leave such transaction not recoverable.
     */
 
+    wait_for_binlog_sync();
     mysql_mutex_lock(&LOCK_after_binlog_sync);
     mysql_mutex_lock(&LOCK_commit_ordered);
     mysql_mutex_unlock(&LOCK_after_binlog_sync);
@@ -5446,6 +5449,7 @@ int MYSQL_BIN_LOG::new_file_impl()
     DBUG_RETURN(error);
   }
 
+  wait_for_binlog_sync();
   mysql_mutex_lock(&LOCK_index);
 
   /* Reuse old name if not binlog and not update log */
@@ -5710,9 +5714,32 @@ bool MYSQL_BIN_LOG::write_event_buffer(uchar* buf, uint len)
 
 bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
 {
-  int err=0, fd=log_file.file;
+  File fd= -1;
   if (synced)
     *synced= 0;
+  wait_for_binlog_sync();
+  if (flush_for_sync(&fd))
+    return 1;
+  if (fd < 0)
+    return 0;
+  if (synced)
+    *synced= 1;
+  return sync_binlog_file(fd);
+}
+
+
+/*
+  Flush the log file and find out if it is to be synced now, according to
+  sync_binlog or sync_relay_log.
+
+  @param[out] sync_fd  set to the file to sync, unchanged if no sync is due
+
+  @retval 0 Success
+  @retval 1 Failure
+*/
+
+bool MYSQL_BIN_LOG::flush_for_sync(File *sync_fd)
+{
   mysql_mutex_assert_owner(&LOCK_log);
   if (flush_io_cache(&log_file))
     return 1;
@@ -5720,17 +5747,41 @@ bool MYSQL_BIN_LOG::flush_and_sync(bool *synced)
   if (sync_period && ++sync_counter >= sync_period)
   {
     sync_counter= 0;
-    err= mysql_file_sync(fd, MYF(MY_WME|MY_SYNC_FILESIZE));
-    if (synced)
-      *synced= 1;
+    *sync_fd= log_file.file;
+  }
+  return 0;
+}
+
+
+bool MYSQL_BIN_LOG::sync_binlog_file(File fd)
+{
+  int err= mysql_file_sync(fd, MYF(MY_WME|MY_SYNC_FILESIZE));
 #ifndef DBUG_OFF
-    if (opt_binlog_dbug_fsync_sleep > 0)
-      my_sleep(opt_binlog_dbug_fsync_sleep);
+  if (opt_binlog_dbug_fsync_sleep > 0)
+    my_sleep(opt_binlog_dbug_fsync_sleep);
 #endif
-  }
   return err;
 }
 
+
+/*
+  Wait until a group commit that syncs the binlog without LOCK_log
+  (binlog_sync_pipeline) has left the sync stage.
+
+  This must be done under LOCK_log before the end of the binlog is moved,
+  the file is closed, or a later commit is ordered after the group, so
+  that none of it can overtake the group.
+*/
+
+void MYSQL_BIN_LOG::wait_for_binlog_sync()
+{
+  mysql_mutex_assert_owner(&LOCK_log);
+  if (is_relay_log)
+    return;
+  mysql_mutex_lock(&LOCK_binlog_sync);
+  mysql_mutex_unlock(&LOCK_binlog_sync);
+}
+
 void MYSQL_BIN_LOG::start_union_events(THD *thd, query_id_t query_id_param)
 {
   DBUG_ASSERT(!thd->binlog_evt_union.do_union);
@@ -7418,6 +7469,7 @@ int MYSQL_BIN_LOG::rotate_and_purge(bool force_rotate,
           checkpoint notification request until early binlogged
           concurrent commits have has been completed.
   */
+  wait_for_binlog_sync();
   mysql_mutex_lock(&LOCK_after_binlog_sync);
   mysql_mutex_unlock(&LOCK_log);
   mysql_mutex_lock(&LOCK_commit_ordered);
@@ -8409,6 +8461,7 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
   bool check_purge= false;
   ulong UNINIT_VAR(binlog_id);
   uint64 commit_id;
+  File sync_fd= -1;
   DBUG_ENTER("MYSQL_BIN_LOG::trx_group_commit_leader");
 
   {
@@ -8523,9 +8576,28 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     }
     set_current_thd(leader->thd);
 
-    bool synced= 0;
-    if (unlikely(flush_and_sync(&synced)))
+    /*
+      With binlog_sync_pipeline, the binlog is synced after LOCK_log is
+      released, so that the next group can write to the binlog while this
+      one waits for the sync. Not when this group will rotate the binlog,
+      as that closes the file.
+    */
+    bool error;
+    if (opt_binlog_sync_pipeline && commit_offset < (my_off_t) max_size)
     {
+      /*
+        The previous group may still be in the sync stage; we wait for it
+        only when we take LOCK_binlog_sync below.
+      */
+      if (!(error= flush_for_sync(&sync_fd)) && sync_fd < 0)
+        wait_for_binlog_sync();
+    }
+    else
+      error= flush_and_sync(0);
+
+    if (unlikely(error))
+    {
+      sync_fd= -1;
       for (current= queue; current != NULL; current= current->next)
       {
         if (!current->error)
@@ -8536,45 +8608,11 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
         }
       }
     }
-    else
+    else if (sync_fd < 0)
     {
       DEBUG_SYNC(leader->thd, "commit_before_update_binlog_end_pos");
-      bool any_error= false;
-
-      mysql_mutex_assert_not_owner(&LOCK_prepare_ordered);
       mysql_mutex_assert_owner(&LOCK_log);
-      mysql_mutex_assert_not_owner(&LOCK_after_binlog_sync);
-      mysql_mutex_assert_not_owner(&LOCK_commit_ordered);
-
-      for (current= queue; current != NULL; current= current->next)
-      {
-#ifdef HAVE_REPLICATION
-        if (likely(!current->error) &&
-            unlikely(repl_semisync_master.
-                     report_binlog_update(current->thd,
-                                          current->cache_mngr->
-                                          last_commit_pos_file,
-                                          current->cache_mngr->
-                                          last_commit_pos_offset)))
-        {
-          current->error= ER_ERROR_ON_WRITE;
-          current->commit_errno= -1;
-          current->error_cache= NULL;
-          any_error= true;
-        }
-#endif
-      }
-
-      /*
-        update binlog_end_pos so it can be read by dump thread
-        Note: must be _after_ the RUN_HOOK(after_flush) or else
-        semi-sync might not have put the transaction into
-        it's list before dump-thread tries to send it
-      */
-      update_binlog_end_pos(commit_offset);
-
-      if (unlikely(any_error))
-        sql_print_error("Failed to run 'after_flush' hooks");
+      report_group_binlog_update(queue, commit_offset);
     }
 
     /*
@@ -8611,17 +8649,56 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
     commit_offset= my_b_write_tell(&log_file);
   }
 
-  DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
-  mysql_mutex_lock(&LOCK_after_binlog_sync);
-  /*
-    We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
-    otherwise scheduling could allow the next group commit to run ahead of us,
-    messing up the order of commit_ordered() calls. But as soon as
-    LOCK_after_binlog_sync is obtained, we can let the next group commit start.
-  */
-  mysql_mutex_unlock(&LOCK_log);
+  if (sync_fd >= 0)
+  {
+    /*
+      Sync stage. LOCK_binlog_sync is chained between LOCK_log and
+      LOCK_after_binlog_sync in the same way, so the groups stay in order.
+      Anything that needs the binlog to be synced up to LOCK_log, or that
+      closes the file, calls wait_for_binlog_sync() first.
+    */
+    mysql_mutex_lock(&LOCK_binlog_sync);
+    mysql_mutex_unlock(&LOCK_log);
 
-  DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+    DEBUG_SYNC(leader->thd, "commit_before_binlog_sync");
+    if (unlikely(sync_binlog_file(sync_fd)))
+    {
+      for (current= queue; current != NULL; current= current->next)
+      {
+        if (!current->error)
+        {
+          current->error= ER_ERROR_ON_WRITE;
+          current->commit_errno= errno;
+          current->error_cache= NULL;
+        }
+      }
+    }
+    else
+    {
+      DEBUG_SYNC(leader->thd, "commit_before_update_binlog_end_pos");
+      report_group_binlog_update(queue, commit_offset);
+    }
+
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    mysql_mutex_unlock(&LOCK_binlog_sync);
+  }
+  else
+  {
+    DEBUG_SYNC(leader->thd, "commit_before_get_LOCK_after_binlog_sync");
+    mysql_mutex_lock(&LOCK_after_binlog_sync);
+    /*
+      We cannot unlock LOCK_log until we have locked LOCK_after_binlog_sync;
+      otherwise scheduling could allow the next group commit to run ahead of
+      us, messing up the order of commit_ordered() calls. But as soon as
+      LOCK_after_binlog_sync is obtained, we can let the next group commit
+      start.
+    */
+    mysql_mutex_unlock(&LOCK_log);
+
+    DEBUG_SYNC(leader->thd, "commit_after_release_LOCK_log");
+  }
 
   /*
     Loop through threads and run the binlog_sync hook
@@ -8739,6 +8816,57 @@ MYSQL_BIN_LOG::trx_group_commit_leader(group_commit_entry *leader)
 }
 
 
+/*
+  Run the after_flush hook for the transactions of a group commit that is
+  written to the binlog (and synced, if sync_binlog says so), and let the
+  binlog dump threads read up to the end of the group.
+
+  Called with LOCK_log, or with LOCK_binlog_sync in the sync stage.
+*/
+
+void
+MYSQL_BIN_LOG::report_group_binlog_update(group_commit_entry *queue,
+                                          my_off_t commit_offset)
+{
+  bool any_error= false;
+
+  mysql_mutex_assert_not_owner(&LOCK_prepare_ordered);
+  mysql_mutex_assert_not_owner(&LOCK_after_binlog_sync);
+  mysql_mutex_assert_not_owner(&LOCK_commit_ordered);
+
+  for (group_commit_entry *current= queue; current != NULL;
+       current= current->next)
+  {
+#ifdef HAVE_REPLICATION
+    if (likely(!current->error) &&
+        unlikely(repl_semisync_master.
+                 report_binlog_update(current->thd,
+                                      current->cache_mngr->
+                                      last_commit_pos_file,
+                                      current->cache_mngr->
+                                      last_commit_pos_offset)))
+    {
+      current->error= ER_ERROR_ON_WRITE;
+      current->commit_errno= -1;
+      current->error_cache= NULL;
+      any_error= true;
+    }
+#endif
+  }
+
+  /*
+    update binlog_end_pos so it can be read by dump thread
+    Note: must be _after_ the RUN_HOOK(after_flush) or else
+    semi-sync might not have put the transaction into
+    it's list before dump-thread tries to send it
+  */
+  update_binlog_end_pos(commit_offset);
+
+  if (unlikely(any_error))
+    sql_print_error("Failed to run 'after_flush' hooks");
+}
+
+
 int
 MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
                                          uint64 commit_id)
@@ -9036,6 +9164,7 @@ void MYSQL_BIN_LOG::close(uint exiting)
 
   if (log_state == LOG_OPENED)
   {
+    wait_for_binlog_sync();
     DBUG_ASSERT(log_type == LOG_BIN);
 #ifdef HAVE_REPLICATION
     if (exiting & LOG_CLOSE_STOP_EVENT)
@@ -11870,10 +11999,23 @@ static MYSQL_SYSVAR_ENUM(
   BINLOG_CHECKSUM_ALG_CRC32,
   &binlog_checksum_typelib);
 
+static MYSQL_SYSVAR_BOOL(
+  sync_pipeline,
+  opt_binlog_sync_pipeline,
+  PLUGIN_VAR_OPCMDARG,
+  "Sync the binary log for a group commit after the binary log lock is "
+  "released, so that the next group commit can write to the binary log "
+  "while the previous one is synced. Only takes effect if sync_binlog is "
+  "non-zero.",
+  NULL,
+  NULL,
+  0);
+
 static struct st_mysql_sys_var *binlog_sys_vars[]=
 {
   MYSQL_SYSVAR(optimize_thread_scheduling),
   MYSQL_SYSVAR(checksum),
+  MYSQL_SYSVAR(sync_pipeline),
   NULL
 };
 
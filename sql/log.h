@@ -89,11 +89,12 @@ class TC_LOG
 */
 extern mysql_mutex_t LOCK_prepare_ordered;
 extern mysql_cond_t COND_prepare_ordered;
+extern mysql_mutex_t LOCK_binlog_sync;
 extern mysql_mutex_t LOCK_after_binlog_sync;
 extern mysql_mutex_t LOCK_commit_ordered;
 #ifdef HAVE_PSI_INTERFACE
 extern PSI_mutex_key key_LOCK_prepare_ordered, key_LOCK_commit_ordered;
-extern PSI_mutex_key key_LOCK_after_binlog_sync;
+extern PSI_mutex_key key_LOCK_binlog_sync, key_LOCK_after_binlog_sync;
 extern PSI_cond_key key_COND_prepare_ordered;
 #endif
 
@@ -573,6 +574,11 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   int queue_for_group_commit(group_commit_entry *entry);
   bool write_transaction_to_binlog_events(group_commit_entry *entry);
   void trx_group_commit_leader(group_commit_entry *leader);
+  void report_group_binlog_update(group_commit_entry *queue,
+                                  my_off_t commit_offset);
+  bool flush_for_sync(File *sync_fd);
+  bool sync_binlog_file(File fd);
+  void wait_for_binlog_sync();
   bool is_xidlist_idle_nolock();
 public:
   /*
@@ -779,7 +785,9 @@ class MYSQL_BIN_LOG: public TC_LOG, private MYSQL_LOG
   }
   void update_binlog_end_pos(my_off_t pos)
   {
-    mysql_mutex_assert_owner(&LOCK_log);
+    /* The sync stage of group commit holds LOCK_binlog_sync instead */
+    DBUG_ASSERT(mysql_mutex_is_owner(&LOCK_log) ||
+                mysql_mutex_is_owner(&LOCK_binlog_sync));
     mysql_mutex_assert_not_owner(&LOCK_binlog_end_pos);
     lock_binlog_end_pos();
     /*
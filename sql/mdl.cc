@@ -38,10 +38,15 @@ static PSI_memory_key key_memory_MDL_context_acquire_locks;
 
 #ifdef HAVE_PSI_INTERFACE
 static PSI_mutex_key key_MDL_wait_LOCK_wait_status;
+static PSI_mutex_key key_MDL_context_LOCK_fast_path;
+static PSI_mutex_key key_LOCK_mdl_fast_path_contexts;
 
 static PSI_mutex_info all_mdl_mutexes[]=
 {
-  { &key_MDL_wait_LOCK_wait_status, "MDL_wait::LOCK_wait_status", 0}
+  { &key_MDL_wait_LOCK_wait_status, "MDL_wait::LOCK_wait_status", 0},
+  { &key_MDL_context_LOCK_fast_path, "MDL_context::LOCK_fast_path", 0},
+  { &key_LOCK_mdl_fast_path_contexts, "LOCK_mdl_fast_path_contexts",
+    PSI_FLAG_GLOBAL}
 };
 
 static PSI_rwlock_key key_MDL_lock_rwlock;
@@ -174,6 +179,8 @@ class MDL_map
   void init();
   void destroy();
   MDL_lock *find_or_insert(LF_PINS *pins, const MDL_key *key);
+  MDL_lock *acquire_fast_path(LF_PINS *pins, const MDL_key *key,
+                              enum_mdl_type type);
   unsigned long get_lock_owner(LF_PINS *pins, const MDL_key *key);
   void remove(LF_PINS *pins, MDL_lock *lock);
   LF_PINS *get_pins() { return lf_hash_get_pins(&m_locks); }
@@ -579,6 +586,145 @@ class MDL_lock
   */
   mysql_prlock_t m_rwlock;
 
+  /**
+    Lock types of the object locks that can be granted on the fast path.
+    They are compatible with each other, and their requests are only in
+    conflict with the other, obtrusive, lock types.
+  */
+  static constexpr bitmap_t fast_path_types=
+    MDL_BIT(MDL_SHARED) | MDL_BIT(MDL_SHARED_HIGH_PRIO) |
+    MDL_BIT(MDL_SHARED_READ) | MDL_BIT(MDL_SHARED_WRITE);
+  /** Number of bits in m_fast_path_state for each of fast_path_types */
+  static constexpr uint FAST_PATH_BITS= 15;
+  static constexpr uint64_t FAST_PATH_COUNT_MAX= (1ULL << FAST_PATH_BITS) - 1;
+  static constexpr uint64_t FAST_PATH_COUNTERS= (1ULL << 4 * FAST_PATH_BITS) - 1;
+  /** An obtrusive ticket is granted or waiting; use m_rwlock */
+  static constexpr uint64_t FAST_PATH_OBTRUSIVE= 1ULL << 4 * FAST_PATH_BITS;
+  /** The object is being removed from MDL_map; look it up again */
+  static constexpr uint64_t FAST_PATH_DESTROYED= FAST_PATH_OBTRUSIVE << 1;
+
+  /**
+    Fast path of the object locks (MDL_object_lock strategy).
+
+    A ticket of one of fast_path_types is granted by incrementing its
+    counter in this word, without m_rwlock, and without being added to
+    m_granted. A statement that only reads or writes the rows of a table
+    thus does not serialize on m_rwlock with the other statements that
+    use the table.
+
+    The acquirer of an obtrusive lock sets FAST_PATH_OBTRUSIVE under
+    m_rwlock, which sends all further requests to the slow path, and
+    then takes the counters into account in can_grant_lock(). The tickets
+    on the fast path are released under m_rwlock while the flag is set,
+    so that the waiters are rescheduled.
+
+    A context moves its tickets from the fast path to m_granted before
+    it requests an obtrusive lock, so that they do not conflict with the
+    request, and before it starts waiting, so that the deadlock detector
+    sees them. A ticket on the fast path only delays a context that
+    is not waiting for anything, so it cannot be part of a deadlock.
+  */
+  std::atomic<uint64_t> m_fast_path_state;
+
+  static bool is_fast_path_type(const MDL_key *key, enum_mdl_type type)
+  {
+    return key->mdl_namespace() != MDL_key::BACKUP &&
+           key->mdl_namespace() != MDL_key::SCHEMA &&
+           (MDL_BIT(type) & fast_path_types);
+  }
+
+  static uint64_t fast_path_unit(enum_mdl_type type)
+  {
+    DBUG_ASSERT(MDL_BIT(type) & fast_path_types);
+    return 1ULL << (type - MDL_SHARED) * FAST_PATH_BITS;
+  }
+
+  /** @return the types of the tickets that are granted on the fast path */
+  bitmap_t fast_path_bitmap() const
+  {
+    uint64_t state= m_fast_path_state.load(std::memory_order_acquire);
+    bitmap_t bitmap= 0;
+    for (int type= MDL_SHARED; type <= MDL_SHARED_WRITE; type++)
+      if (state & FAST_PATH_COUNT_MAX << (type - MDL_SHARED) * FAST_PATH_BITS)
+        bitmap|= MDL_BIT(type);
+    return bitmap;
+  }
+
+  bool has_fast_path_tickets() const
+  {
+    return m_fast_path_state.load(std::memory_order_relaxed) &
+           FAST_PATH_COUNTERS;
+  }
+
+  /**
+    Try to grant a ticket on the fast path.
+    @return whether the ticket was granted
+  */
+  bool acquire_fast_path(enum_mdl_type type)
+  {
+    const uint64_t unit= fast_path_unit(type);
+    uint64_t state= m_fast_path_state.load(std::memory_order_relaxed);
+    do
+    {
+      if ((state & (FAST_PATH_OBTRUSIVE | FAST_PATH_DESTROYED)) ||
+          (state & unit * FAST_PATH_COUNT_MAX) == unit * FAST_PATH_COUNT_MAX)
+        return false;
+    }
+    while (!m_fast_path_state.compare_exchange_weak(state, state + unit,
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_relaxed));
+    return true;
+  }
+
+  void release_fast_path(LF_PINS *pins, enum_mdl_type type);
+
+  /**
+    Send further requests to the slow path before an obtrusive ticket is
+    granted or added to m_waiting.
+    @pre m_rwlock is write-locked
+  */
+  void block_fast_path(enum_mdl_type type)
+  {
+    if (m_strategy == &m_object_lock_strategy &&
+        !(MDL_BIT(type) & fast_path_types) &&
+        !(m_fast_path_state.load(std::memory_order_relaxed) &
+          FAST_PATH_OBTRUSIVE))
+      m_fast_path_state.fetch_or(FAST_PATH_OBTRUSIVE,
+                                 std::memory_order_acq_rel);
+  }
+
+  /**
+    Allow the fast path again unless an obtrusive ticket is still
+    granted or waiting.
+    @pre m_rwlock is write-locked
+  */
+  void unblock_fast_path()
+  {
+    if ((m_fast_path_state.load(std::memory_order_relaxed) &
+         FAST_PATH_OBTRUSIVE) &&
+        !((m_granted.bitmap() | m_waiting.bitmap()) & ~fast_path_types))
+      m_fast_path_state.fetch_and(~FAST_PATH_OBTRUSIVE,
+                                  std::memory_order_release);
+  }
+
+  /**
+    Prevent further use of the fast path if no ticket is granted on it.
+    @pre m_rwlock is write-locked and is_empty()
+    @return whether the object can be removed from MDL_map
+  */
+  bool mark_destroyed()
+  {
+    uint64_t state= m_fast_path_state.load(std::memory_order_relaxed);
+    do
+      if (state & FAST_PATH_COUNTERS)
+        return false;
+    while (!m_fast_path_state.compare_exchange_weak(state,
+                                                    FAST_PATH_DESTROYED,
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_relaxed));
+    return true;
+  }
+
   bool is_empty() const
   {
     return (m_granted.is_empty() && m_waiting.is_empty());
@@ -643,12 +789,14 @@ class MDL_lock
 public:
 
   MDL_lock()
-    : m_hog_lock_count(0),
+    : m_fast_path_state(0),
+      m_hog_lock_count(0),
       m_strategy(0)
   { mysql_prlock_init(key_MDL_lock_rwlock, &m_rwlock); }
 
   MDL_lock(const MDL_key *key_arg)
   : key(key_arg),
+    m_fast_path_state(0),
     m_hog_lock_count(0),
     m_strategy(&m_backup_lock_strategy)
   {
@@ -670,6 +818,7 @@ class MDL_lock
   {
     DBUG_ASSERT(key_arg->mdl_namespace() != MDL_key::BACKUP);
     new (&lock->key) MDL_key(key_arg);
+    lock->m_fast_path_state.store(0, std::memory_order_relaxed);
     if (key_arg->mdl_namespace() == MDL_key::SCHEMA)
       lock->m_strategy= &m_scoped_lock_strategy;
     else
@@ -691,6 +840,11 @@ const MDL_lock::MDL_object_lock MDL_lock::m_object_lock_strategy;
 
 static MDL_map mdl_locks;
 
+/** The contexts that have used the fast path, for mdl_iterate() */
+static ilist<MDL_context> mdl_fast_path_contexts;
+/** Protects mdl_fast_path_contexts */
+static mysql_mutex_t LOCK_mdl_fast_path_contexts;
+
 
 extern "C"
 {
@@ -725,6 +879,8 @@ void mdl_init()
   init_mdl_psi_keys();
 #endif
 
+  mysql_mutex_init(key_LOCK_mdl_fast_path_contexts,
+                   &LOCK_mdl_fast_path_contexts, MY_MUTEX_INIT_FAST);
   mdl_locks.init();
 }
 
@@ -742,6 +898,8 @@ void mdl_destroy()
   {
     mdl_initialized= FALSE;
     mdl_locks.destroy();
+    DBUG_ASSERT(mdl_fast_path_contexts.empty());
+    mysql_mutex_destroy(&LOCK_mdl_fast_path_contexts);
   }
 }
 
@@ -764,6 +922,8 @@ static my_bool mdl_iterate_lock(MDL_lock *lock, mdl_iterate_arg *arg)
                         [arg](MDL_ticket &ticket) {
                           return arg->callback(&ticket, arg->argument, true);
                         });
+  if (!res && lock->has_fast_path_tickets())
+    res= MDL_context::iterate_fast_path(lock, arg->callback, arg->argument);
   res= std::any_of(lock->m_waiting.begin(), lock->m_waiting.end(),
                    [arg](MDL_ticket &ticket) {
                      return arg->callback(&ticket, arg->argument, false);
@@ -876,6 +1036,39 @@ MDL_lock* MDL_map::find_or_insert(LF_PINS *pins, const MDL_key *mdl_key)
 }
 
 
+/**
+  Find or create the MDL_lock object for the key, and grant a ticket
+  on its fast path.
+
+  @retval non-NULL - Success. The ticket is counted in
+                     MDL_lock::m_fast_path_state.
+  @retval NULL     - The request must take the slow path.
+*/
+
+MDL_lock *MDL_map::acquire_fast_path(LF_PINS *pins, const MDL_key *mdl_key,
+                                     enum_mdl_type type)
+{
+  MDL_lock *lock;
+
+  DBUG_ASSERT(MDL_lock::is_fast_path_type(mdl_key, type));
+
+  while (!(lock= (MDL_lock*) lf_hash_search(&m_locks, pins, mdl_key->ptr(),
+                                            mdl_key->length())))
+    if (lf_hash_insert(&m_locks, pins, (uchar*) mdl_key) == -1)
+      return NULL;
+
+  /*
+    The object can not be freed while it is pinned, and it can not be
+    removed from the hash while a ticket is on its fast path.
+  */
+  if (!lock->acquire_fast_path(type))
+    lock= NULL;
+  lf_hash_search_unpin(pins);
+
+  return lock;
+}
+
+
 /**
  * Return thread id of the owner of the lock, if it is owned.
  */
@@ -943,9 +1136,12 @@ MDL_context::MDL_context()
   m_owner(NULL),
   m_needs_thr_lock_abort(FALSE),
   m_waiting_for(NULL),
-  m_pins(NULL)
+  m_pins(NULL),
+  m_fast_path_registered(false)
 {
   mysql_prlock_init(key_MDL_context_LOCK_waiting_for, &m_LOCK_waiting_for);
+  mysql_mutex_init(key_MDL_context_LOCK_fast_path, &m_LOCK_fast_path,
+                   MY_MUTEX_INIT_FAST);
 }
 
 
@@ -966,8 +1162,18 @@ void MDL_context::destroy()
   DBUG_ASSERT(m_tickets[MDL_STATEMENT].is_empty());
   DBUG_ASSERT(m_tickets[MDL_TRANSACTION].is_empty());
   DBUG_ASSERT(m_tickets[MDL_EXPLICIT].is_empty());
+  DBUG_ASSERT(m_fast_path_tickets.empty());
+
+  if (m_fast_path_registered)
+  {
+    mysql_mutex_lock(&LOCK_mdl_fast_path_contexts);
+    mdl_fast_path_contexts.remove(*this);
+    mysql_mutex_unlock(&LOCK_mdl_fast_path_contexts);
+    m_fast_path_registered= false;
+  }
 
   mysql_prlock_destroy(&m_LOCK_waiting_for);
+  mysql_mutex_destroy(&m_LOCK_fast_path);
   if (m_pins)
     lf_hash_put_pins(m_pins);
 }
@@ -1770,6 +1976,14 @@ MDL_lock::can_grant_lock(enum_mdl_type type_arg,
   if (!ignore_lock_priority && (m_waiting.bitmap() & waiting_incompat_map))
     return false;
 
+  /*
+    The tickets on the fast path belong to other contexts: a context
+    moves its own tickets to m_granted before it requests an obtrusive
+    lock.
+  */
+  if (fast_path_bitmap() & granted_incompat_map)
+    return false;
+
   if (m_granted.bitmap() & granted_incompat_map)
   {
     bool can_grant= true;
@@ -1831,10 +2045,11 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 {
   mysql_prlock_wrlock(&m_rwlock);
   (this->*list).remove_ticket(ticket);
-  if (is_empty())
+  if (is_empty() && mark_destroyed())
     mdl_locks.remove(pins, this);
   else
   {
+    unblock_fast_path();
     /*
       There can be some contexts waiting to acquire a lock
       which now might be able to do it. Grant the lock to
@@ -1855,6 +2070,41 @@ void MDL_lock::remove_ticket(LF_PINS *pins, Ticket_list MDL_lock::*list,
 }
 
 
+/**
+  Release a ticket that was granted on the fast path.
+
+  m_rwlock is only acquired if an obtrusive ticket is granted or waiting,
+  so that the waiters are rescheduled, or if this is the last ticket on
+  the fast path, so that the object can be removed from MDL_map.
+*/
+
+void MDL_lock::release_fast_path(LF_PINS *pins, enum_mdl_type type)
+{
+  const uint64_t unit= fast_path_unit(type);
+  uint64_t state= m_fast_path_state.load(std::memory_order_relaxed);
+
+  while (!(state & FAST_PATH_OBTRUSIVE) &&
+         (state & FAST_PATH_COUNTERS) != unit)
+  {
+    DBUG_ASSERT(state & unit * FAST_PATH_COUNT_MAX);
+    if (m_fast_path_state.compare_exchange_weak(state, state - unit,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed))
+      return;
+  }
+
+  mysql_prlock_wrlock(&m_rwlock);
+  m_fast_path_state.fetch_sub(unit, std::memory_order_release);
+  if (is_empty() && mark_destroyed())
+    mdl_locks.remove(pins, this);
+  else
+  {
+    reschedule_waiters();
+    mysql_prlock_unlock(&m_rwlock);
+  }
+}
+
+
 /**
   Check if we have any pending locks which conflict with existing
   shared lock.
@@ -2026,6 +2276,7 @@ MDL_context::try_acquire_lock(MDL_request *mdl_request)
       is no need to release it.
     */
     DBUG_ASSERT(! ticket->m_lock->is_empty());
+    ticket->m_lock->unblock_fast_path();
     mysql_prlock_unlock(&ticket->m_lock->m_rwlock);
     MDL_ticket::destroy(ticket);
   }
@@ -2110,13 +2361,6 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                    )))
     return TRUE;
 
-  /* The below call implicitly locks MDL_lock::m_rwlock on success. */
-  if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
-  {
-    MDL_ticket::destroy(ticket);
-    return TRUE;
-  }
-
   DBUG_ASSERT(ticket->m_psi == NULL);
   ticket->m_psi= mysql_mdl_create(ticket,
                                   &mdl_request->key,
@@ -2126,7 +2370,34 @@ MDL_context::try_acquire_lock_impl(MDL_request *mdl_request,
                                   mdl_request->m_src_file,
                                   mdl_request->m_src_line);
 
+  if (MDL_lock::is_fast_path_type(key, mdl_request->type))
+  {
+    if (fast_path_allowed() &&
+        (lock= mdl_locks.acquire_fast_path(m_pins, key, mdl_request->type)))
+    {
+      ticket->m_lock= lock;
+      ticket->m_fast_path= true;
+      add_fast_path_ticket(ticket);
+      m_tickets[mdl_request->duration].push_front(ticket);
+      mdl_request->ticket= ticket;
+      mysql_mdl_set_status(ticket->m_psi, MDL_ticket::GRANTED);
+      return FALSE;
+    }
+  }
+  else if (key->mdl_namespace() != MDL_key::BACKUP &&
+           key->mdl_namespace() != MDL_key::SCHEMA)
+    /* Our own tickets must not conflict with the request. */
+    materialize_fast_path_locks();
+
+  /* The below call implicitly locks MDL_lock::m_rwlock on success. */
+  if (!(lock= mdl_locks.find_or_insert(m_pins, key)))
+  {
+    MDL_ticket::destroy(ticket);
+    return TRUE;
+  }
+
   ticket->m_lock= lock;
+  lock->block_fast_path(mdl_request->type);
 
   if (lock->can_grant_lock(mdl_request->type, this, false))
   {
@@ -2215,6 +2486,95 @@ MDL_context::clone_ticket(MDL_request *mdl_request)
 }
 
 
+/** @return whether the locks of this context may use the fast path */
+
+bool MDL_context::fast_path_allowed() const
+{
+  /*
+    MDL_lock::notify_conflicting_locks() and the conflict resolution of
+    Galera only look at MDL_lock::m_granted.
+  */
+  if (m_needs_thr_lock_abort)
+    return false;
+#ifdef WITH_WSREP
+  if (WSREP_ON)
+    return false;
+#endif /* WITH_WSREP */
+  return true;
+}
+
+
+/** Remember a ticket that was granted on the fast path. */
+
+void MDL_context::add_fast_path_ticket(MDL_ticket *ticket)
+{
+  if (!m_fast_path_registered)
+  {
+    mysql_mutex_lock(&LOCK_mdl_fast_path_contexts);
+    mdl_fast_path_contexts.push_back(*this);
+    mysql_mutex_unlock(&LOCK_mdl_fast_path_contexts);
+    m_fast_path_registered= true;
+  }
+  mysql_mutex_lock(&m_LOCK_fast_path);
+  m_fast_path_tickets.push_back(*ticket);
+  mysql_mutex_unlock(&m_LOCK_fast_path);
+}
+
+
+/**
+  Move the tickets of this context from the fast path to
+  MDL_lock::m_granted, where other contexts and the deadlock
+  detector can see them.
+*/
+
+void MDL_context::materialize_fast_path_locks()
+{
+  while (!m_fast_path_tickets.empty())
+  {
+    MDL_ticket *ticket= &m_fast_path_tickets.front();
+    MDL_lock *lock= ticket->m_lock;
+
+    mysql_prlock_wrlock(&lock->m_rwlock);
+    mysql_mutex_lock(&m_LOCK_fast_path);
+    m_fast_path_tickets.remove(*ticket);
+    mysql_mutex_unlock(&m_LOCK_fast_path);
+    /* The object can not be removed while the ticket is in m_granted. */
+    lock->m_fast_path_state.fetch_sub(MDL_lock::fast_path_unit(ticket->m_type),
+                                      std::memory_order_relaxed);
+    ticket->m_fast_path= false;
+    lock->m_granted.add_ticket(ticket);
+    mysql_prlock_unlock(&lock->m_rwlock);
+  }
+}
+
+
+/**
+  Invoke a callback for the tickets of all contexts that are granted
+  on the fast path of a lock.
+
+  @pre MDL_lock::m_rwlock of the lock is locked
+*/
+
+bool MDL_context::iterate_fast_path(const MDL_lock *lock,
+                                    mdl_iterator_callback callback, void *arg)
+{
+  bool res= false;
+  mysql_mutex_lock(&LOCK_mdl_fast_path_contexts);
+  for (MDL_context &ctx : mdl_fast_path_contexts)
+  {
+    mysql_mutex_lock(&ctx.m_LOCK_fast_path);
+    for (MDL_ticket &ticket : ctx.m_fast_path_tickets)
+      if (ticket.m_lock == lock && (res= callback(&ticket, arg, true)))
+        break;
+    mysql_mutex_unlock(&ctx.m_LOCK_fast_path);
+    if (res)
+      break;
+  }
+  mysql_mutex_unlock(&LOCK_mdl_fast_path_contexts);
+  return res;
+}
+
+
 /**
   Check if there is any conflicting lock that could cause this thread
   to wait for another thread which is not ready to commit.
@@ -2324,6 +2684,7 @@ MDL_context::acquire_lock(MDL_request *mdl_request, double lock_wait_timeout)
   if (lock_wait_timeout == 0)
   {
     DBUG_PRINT("mdl", ("Nowait:  %s", ticket_msg));
+    lock->unblock_fast_path();
     mysql_prlock_unlock(&lock->m_rwlock);
     MDL_ticket::destroy(ticket);
     my_error(ER_LOCK_WAIT_TIMEOUT, MYF(0));
@@ -2613,6 +2974,10 @@ MDL_context::upgrade_shared_lock(MDL_ticket *mdl_ticket,
   if (acquire_lock(&mdl_xlock_request, lock_wait_timeout))
     DBUG_RETURN(TRUE);
 
+  /* The merge below works on MDL_lock::m_granted */
+  if (mdl_ticket->m_fast_path || mdl_xlock_request.ticket->m_fast_path)
+    materialize_fast_path_locks();
+
   is_new_ticket= ! has_lock(mdl_svp, mdl_xlock_request.ticket);
 
   /* Merge the acquired and the original lock. @todo: move to a method. */
@@ -2899,7 +3264,15 @@ void MDL_context::release_lock(enum_mdl_duration duration, MDL_ticket *ticket)
   DBUG_ASSERT(this == ticket->get_ctx());
   DBUG_PRINT("mdl", ("Released: %s", dbug_print_mdl(ticket)));
 
-  lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
+  if (ticket->m_fast_path)
+  {
+    mysql_mutex_lock(&m_LOCK_fast_path);
+    m_fast_path_tickets.remove(*ticket);
+    mysql_mutex_unlock(&m_LOCK_fast_path);
+    lock->release_fast_path(m_pins, ticket->get_type());
+  }
+  else
+    lock->remove_ticket(m_pins, &MDL_lock::m_granted, ticket);
 
   m_tickets[duration].remove(ticket);
   MDL_ticket::destroy(ticket);
@@ -3015,6 +3388,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
                (m_type == MDL_BACKUP_DDL ||
                 m_type == MDL_BACKUP_BLOCK_DDL ||
                 m_type == MDL_BACKUP_WAIT_FLUSH)));
+  DBUG_ASSERT(!m_fast_path);
 
   mysql_prlock_wrlock(&m_lock->m_rwlock);
   /*
@@ -3024,6 +3398,7 @@ void MDL_ticket::downgrade_lock(enum_mdl_type type)
   m_lock->m_granted.remove_ticket(this);
   m_type= type;
   m_lock->m_granted.add_ticket(this);
+  m_lock->unblock_fast_path();
   m_lock->reschedule_waiters();
   mysql_prlock_unlock(&m_lock->m_rwlock);
   DBUG_VOID_RETURN;
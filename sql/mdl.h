@@ -747,7 +747,8 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
 #endif
      m_ctx(ctx_arg),
      m_lock(NULL),
-     m_psi(NULL)
+     m_psi(NULL),
+     m_fast_path(false)
   {}
 
   virtual ~MDL_ticket()
@@ -783,6 +784,13 @@ class MDL_ticket : public MDL_wait_for_subgraph, public ilist_node<>
 
   PSI_metadata_lock *m_psi;
 
+  /**
+    Whether the lock was granted on the fast path, without being added
+    to MDL_lock::m_granted. Context private.
+    @sa MDL_lock::m_fast_path_state
+  */
+  bool m_fast_path;
+
 private:
   MDL_ticket(const MDL_ticket &);               /* not implemented */
   MDL_ticket &operator=(const MDL_ticket &);    /* not implemented */
@@ -861,12 +869,15 @@ typedef I_P_List<MDL_request, I_P_List_adapter<MDL_request,
                  I_P_List_counter>
         MDL_request_list;
 
+typedef int (*mdl_iterator_callback)(MDL_ticket *ticket, void *arg,
+                                     bool granted);
+
 /**
   Context of the owner of metadata locks. I.e. each server
   connection has such a context.
 */
 
-class MDL_context
+class MDL_context : public ilist_node<>
 {
 public:
   typedef I_P_List<MDL_ticket,
@@ -956,6 +967,9 @@ class MDL_context
             will see the new value eventually.
     */
     m_needs_thr_lock_abort= needs_thr_lock_abort;
+    /* Make our locks visible to MDL_lock::notify_conflicting_locks() */
+    if (needs_thr_lock_abort)
+      materialize_fast_path_locks();
   }
   bool get_needs_thr_lock_abort() const
   {
@@ -1053,6 +1067,15 @@ class MDL_context
   MDL_wait_for_subgraph *m_waiting_for;
   LF_PINS *m_pins;
   uint m_deadlock_overweight= 0;
+  /**
+    Tickets granted on the fast path. They are only added and removed
+    by the owner of the context, under m_LOCK_fast_path, so that
+    mdl_iterate() can see them.
+  */
+  ilist<MDL_ticket> m_fast_path_tickets;
+  mysql_mutex_t m_LOCK_fast_path;
+  /** Whether the context is in the list that mdl_iterate() looks at */
+  bool m_fast_path_registered;
 private:
   MDL_ticket *find_ticket(MDL_request *mdl_req,
                           enum_mdl_duration *duration);
@@ -1061,6 +1084,9 @@ class MDL_context
   bool try_acquire_lock_impl(MDL_request *mdl_request,
                              MDL_ticket **out_ticket);
   bool fix_pins();
+  bool fast_path_allowed() const;
+  void add_fast_path_ticket(MDL_ticket *ticket);
+  void materialize_fast_path_locks();
 
 public:
   THD *get_thd() const { return m_owner->get_thd(); }
@@ -1071,9 +1097,17 @@ class MDL_context
 
   bool visit_subgraph(MDL_wait_for_graph_visitor *dvisitor);
 
+  static bool iterate_fast_path(const MDL_lock *lock,
+                                mdl_iterator_callback callback, void *arg);
+
   /** Inform the deadlock detector there is an edge in the wait-for graph. */
   void will_wait_for(MDL_wait_for_subgraph *waiting_for_arg)
   {
+    /*
+      The deadlock detector only looks at MDL_lock::m_granted, so the
+      locks of a waiting context must not be on the fast path.
+    */
+    materialize_fast_path_locks();
     mysql_prlock_wrlock(&m_LOCK_waiting_for);
     m_waiting_for=  waiting_for_arg;
     mysql_prlock_unlock(&m_LOCK_waiting_for);
@@ -1126,8 +1160,6 @@ extern "C" int thd_is_connected(MYSQL_THD thd);
 */
 extern "C" ulong max_write_lock_count;
 
-typedef int (*mdl_iterator_callback)(MDL_ticket *ticket, void *arg,
-                                     bool granted);
 extern MYSQL_PLUGIN_IMPORT
 int mdl_iterate(mdl_iterator_callback callback, void *arg);
 #endif /* MDL_H */
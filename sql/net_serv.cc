@@ -468,6 +468,67 @@ my_bool my_net_write(NET *net, const uchar *packet, size_t len)
 }
 
 
+/**
+  Write a logical packet that is stored in several parts.
+
+  Like my_net_write(), but the parts are not copied into one buffer
+  first. Parts that are longer than the network buffer are sent
+  directly from where they are.
+
+  @param net      NET handler
+  @param parts    pointers to the parts of the packet
+  @param lengths  lengths of the parts
+  @param n_parts  number of parts
+*/
+
+my_bool my_net_write_parts(NET *net, const uchar **parts,
+                           const size_t *lengths, uint n_parts)
+{
+  uchar buff[NET_HEADER_SIZE];
+  size_t len= 0, chunk;
+  uint i= 0;
+  size_t offset= 0;
+
+  if (unlikely(!net->vio)) /* nowhere to write */
+    return 0;
+
+  for (uint j= 0; j < n_parts; j++)
+    len+= lengths[j];
+
+  MYSQL_NET_WRITE_START(len);
+
+  /* Split the packet as my_net_write() does */
+  do
+  {
+    chunk= MY_MIN(len, MAX_PACKET_LENGTH);
+    len-= chunk;
+    int3store(buff, chunk);
+    buff[3]= (uchar) net->pkt_nr++;
+    if (net_write_buff(net, buff, NET_HEADER_SIZE))
+      goto err;
+    for (size_t left= chunk; left; )
+    {
+      size_t n= MY_MIN(left, lengths[i] - offset);
+      if (n && net_write_buff(net, parts[i] + offset, n))
+        goto err;
+      left-= n;
+      if ((offset+= n) == lengths[i])
+      {
+        i++;
+        offset= 0;
+      }
+    }
+  }
+  while (chunk == MAX_PACKET_LENGTH);
+
+  MYSQL_NET_WRITE_DONE(0);
+  return 0;
+err:
+  MYSQL_NET_WRITE_DONE(1);
+  return 1;
+}
+
+
 /**
   Send a command to the server.
 
@@ -633,6 +694,95 @@ net_write_buff(NET *net, const uchar *packet, size_t len)
 }
 
 
+#ifdef HAVE_COMPRESS
+#include <zlib.h>
+
+/**
+  Compressor of the packets that a thread writes.
+
+  compress() would initialize a deflate stream, which allocates a few
+  hundred kilobytes, and my_compress() would allocate two more buffers,
+  for every packet. The stream and the output buffer are instead kept
+  between the packets and the connections that the thread serves.
+  Each packet is still compressed on its own, after deflateReset(),
+  because that is what the protocol requires.
+*/
+class Net_compressor
+{
+  z_stream m_stream;
+  bool m_initialized= false;
+  uchar *m_buf= nullptr;
+  size_t m_size= 0;
+  /** Larger output buffers are freed after each packet */
+  static constexpr size_t KEEP_SIZE= 1U << 20;
+
+public:
+  ~Net_compressor()
+  {
+    if (m_initialized)
+      deflateEnd(&m_stream);
+    my_free(m_buf);
+  }
+
+  /** @return a buffer of at least size bytes, or NULL */
+  uchar *buf(size_t size)
+  {
+    if (size > m_size)
+    {
+      my_free(m_buf);
+      m_size= MY_MAX(size, 16384);
+      if (!(m_buf= (uchar*) my_malloc(key_memory_NET_compress_packet, m_size,
+                                      MYF(MY_WME))))
+        m_size= 0;
+    }
+    return m_buf;
+  }
+
+  /** Free the output buffer if it was enlarged for a huge packet */
+  void shrink()
+  {
+    if (m_size > KEEP_SIZE)
+    {
+      my_free(m_buf);
+      m_buf= nullptr;
+      m_size= 0;
+    }
+  }
+
+  /**
+    Compress a packet.
+    @param to   output of at least len bytes
+    @return length of the compressed packet
+    @retval 0   the packet would not become shorter, or an error occurred
+  */
+  size_t compress(const uchar *from, size_t len, uchar *to)
+  {
+    if (len < MIN_COMPRESS_LENGTH || len != (uInt) len)
+      return 0;
+    if (m_initialized)
+      deflateReset(&m_stream);
+    else
+    {
+      memset(&m_stream, 0, sizeof m_stream);
+      if (deflateInit(&m_stream, Z_DEFAULT_COMPRESSION) != Z_OK)
+        return 0;
+      m_initialized= true;
+    }
+    m_stream.next_in= const_cast<Bytef*>(from);
+    m_stream.avail_in= (uInt) len;
+    m_stream.next_out= to;
+    /* Give up as soon as the output is not shorter than the input */
+    m_stream.avail_out= (uInt) len - 1;
+    if (deflate(&m_stream, Z_FINISH) != Z_STREAM_END)
+      return 0;
+    return m_stream.total_out;
+  }
+};
+
+static thread_local Net_compressor net_compressor;
+#endif /* HAVE_COMPRESS */
+
+
 /**
   Read and write one packet using timeouts.
   If needed, the packet is compressed before sending.
@@ -680,10 +830,7 @@ net_real_write(NET *net,const uchar *packet, size_t len)
     size_t complen;
     uchar *b;
     uint header_length=NET_HEADER_SIZE+COMP_HEADER_SIZE;
-    if (!(b= (uchar*) my_malloc(key_memory_NET_compress_packet,
-                                len + NET_HEADER_SIZE + COMP_HEADER_SIZE + 1,
-                                MYF(MY_WME | (net->thread_specific_malloc
-                                              ? MY_THREAD_SPECIFIC : 0)))))
+    if (!(b= net_compressor.buf(len + header_length)))
     {
       net->error= 2;
       net->last_errno= ER_OUT_OF_RESOURCES;
@@ -691,11 +838,16 @@ net_real_write(NET *net,const uchar *packet, size_t len)
       net->reading_or_writing= 0;
       DBUG_RETURN(1);
     }
-    memcpy(b+header_length,packet,len);
-
     /* Don't compress error packets (compress == 2) */
-    if (net->compress == 2 || my_compress(b+header_length, &len, &complen))
+    if (net->compress != 2 &&
+        (complen= net_compressor.compress(packet, len, b + header_length)))
+      /* Store the length of the original packet in complen */
+      std::swap(len, complen);
+    else
+    {
+      memcpy(b+header_length,packet,len);
       complen=0;
+    }
     int3store(&b[NET_HEADER_SIZE],complen);
     int3store(b,len);
     b[3]=(uchar) (net->compress_pkt_nr++);
@@ -777,7 +929,7 @@ net_real_write(NET *net,const uchar *packet, size_t len)
 #endif
 #ifdef HAVE_COMPRESS
   if (net->compress)
-    my_free((void*) packet);
+    net_compressor.shrink();
 #endif
   if (thr_alarm_in_use(&alarmed))
   {
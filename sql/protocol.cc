@@ -1429,11 +1429,78 @@ bool Protocol::store(I_List<i_string_pair>* str_list)
 void Protocol_text::prepare_for_resend()
 {
   packet->length(0);
+  n_value_refs= 0;
 #ifndef DBUG_OFF
   field_pos= 0;
 #endif
 }
 
+
+/**
+  Send the row with the values that store_value_ref() did not copy.
+*/
+
+bool Protocol_text::write()
+{
+  if (!n_value_refs)
+    return Protocol::write();
+
+  const uchar *parts[array_elements(value_refs) * 2 + 1];
+  size_t lengths[array_elements(value_refs) * 2 + 1];
+  const uchar *ptr= (const uchar*) packet->ptr();
+  size_t pos= 0;
+  uint n= 0;
+
+  for (uint i= 0; i < n_value_refs; i++)
+  {
+    parts[n]= ptr + pos;
+    lengths[n++]= value_refs[i].pos - pos;
+    parts[n]= value_refs[i].ptr;
+    lengths[n++]= value_refs[i].length;
+    pos= value_refs[i].pos;
+  }
+  parts[n]= ptr + pos;
+  lengths[n++]= packet->length() - pos;
+  n_value_refs= 0;
+  return my_net_write_parts(&thd->net, parts, lengths, n);
+}
+
+
+/**
+  Store only the length of a long BLOB or TEXT value in the packet,
+  and let write() send the value from the record buffer.
+
+  The value would otherwise be copied to the packet and then to the
+  network buffer. Values that are longer than the network buffer are
+  not copied at all.
+
+  @return whether an error occurred
+*/
+
+bool Protocol_text::store_value_ref(Field_blob *field)
+{
+  size_t length= field->get_length();
+  size_t packet_length= packet->length();
+
+  if (length < VALUE_REF_MIN_LENGTH ||
+      n_value_refs == array_elements(value_refs) ||
+      field->compression_method() ||
+      needs_conversion(field->charset(), character_set_results()))
+    return field->send(this);
+
+#ifndef DBUG_OFF
+  DBUG_ASSERT(field_handlers == 0 || field_pos < field_count);
+  DBUG_ASSERT(valid_handler(field_pos, PROTOCOL_SEND_STRING));
+  field_pos++;
+#endif
+  if (packet->reserve(9, PACKET_BUFFER_EXTRA_ALLOC))
+    return true;
+  uchar *to= net_store_length((uchar*) packet->ptr() + packet_length, length);
+  packet->length((uint32) (to - (uchar*) packet->ptr()));
+  value_refs[n_value_refs++]= { packet->length(), field->get_ptr(), length };
+  return false;
+}
+
 bool Protocol_text::store_null()
 {
 #ifndef DBUG_OFF
@@ -1613,7 +1680,15 @@ bool Protocol_text::store(Field *field)
     old_map= dbug_tmp_use_all_columns(table, &table->read_set);
 #endif
 
-  bool rc= field->send(this);
+  bool rc;
+#ifndef EMBEDDED_LIBRARY
+  /* Protocol_local keeps the values in its own buffers */
+  if ((field->flags & BLOB_FLAG) && field->type() != MYSQL_TYPE_GEOMETRY &&
+      type() == PROTOCOL_TEXT)
+    rc= store_value_ref((Field_blob*) field);
+  else
+#endif
+    rc= field->send(this);
 
 #ifdef DBUG_ASSERT_EXISTS
   if (old_map)
@@ -27,6 +27,7 @@
 
 class i_string;
 class Field;
+class Field_blob;
 class Send_field;
 class THD;
 class Item_param;
@@ -198,6 +199,24 @@ class Protocol_text :public Protocol
 {
   StringBuffer<FLOATING_POINT_BUFFER> buffer;
   bool store_numeric_string_aux(const char *from, size_t length);
+#ifndef EMBEDDED_LIBRARY
+  /**
+    A BLOB or TEXT value that is not copied to the packet. write() sends
+    it from the record buffer, which is not changed before that.
+  */
+  struct Value_ref
+  {
+    /** offset in packet where the value belongs */
+    size_t pos;
+    const uchar *ptr;
+    size_t length;
+  };
+  /** Shorter values are copied to the packet */
+  static constexpr size_t VALUE_REF_MIN_LENGTH= 4096;
+  Value_ref value_refs[8];
+  uint n_value_refs= 0;
+  bool store_value_ref(Field_blob *field);
+#endif
 public:
   Protocol_text(THD *thd_arg, ulong prealloc= 0)
    :Protocol(thd_arg)
@@ -206,6 +225,9 @@ class Protocol_text :public Protocol
       packet->alloc(prealloc);
   }
   void prepare_for_resend() override;
+#ifndef EMBEDDED_LIBRARY
+  bool write() override;
+#endif
   bool store_null() override;
   bool store_tiny(longlong from) override;
   bool store_short(longlong from) override;
@@ -0,0 +1,176 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#ifdef HAVE_REPLICATION
+
+#include "rpl_dump_cache.h"
+#include "sql_string.h"
+#include "sql_repl.h"                           // compare_log_name
+#include "log_event.h"
+#include "mysqld.h"
+
+Binlog_dump_cache binlog_dump_cache;
+ulonglong opt_binlog_dump_cache_size;
+
+
+void Binlog_dump_cache::init()
+{
+  mysql_rwlock_init(key_rwlock_binlog_dump_cache, &m_lock);
+  m_buf= NULL;
+  m_size= 0;
+  m_log_name[0]= 0;
+  m_start= m_end= 0;
+  m_verified= false;
+}
+
+
+void Binlog_dump_cache::destroy()
+{
+  my_free(m_buf);
+  m_buf= NULL;
+  m_size= 0;
+  mysql_rwlock_destroy(&m_lock);
+}
+
+
+void Binlog_dump_cache::copy(uchar *to, my_off_t pos, size_t len) const
+{
+  DBUG_ASSERT(len <= m_size);
+  const size_t offset= size_t(pos % m_size);
+  const size_t n= MY_MIN(len, m_size - offset);
+  memcpy(to, m_buf + offset, n);
+  memcpy(to + n, m_buf, len - n);
+}
+
+
+size_t Binlog_dump_cache::read(const char *log_name, my_off_t pos,
+                               my_off_t end_pos, bool verified,
+                               String *packet)
+{
+  if (!opt_binlog_dump_cache_size)
+    return 0;
+
+  size_t len= 0;
+  mysql_rwlock_rdlock(&m_lock);
+  if (pos >= m_start && pos + LOG_EVENT_MINIMAL_HEADER_LEN <= m_end &&
+      (m_verified || !verified) && !strcmp(log_name, m_log_name))
+  {
+    uchar buf[4];
+    copy(buf, pos + EVENT_LEN_OFFSET, sizeof buf);
+    len= uint4korr(buf);
+    if (pos + len > MY_MIN(m_end, end_pos) ||
+        packet->reserve(len))
+      len= 0;
+    else
+    {
+      copy((uchar*) packet->ptr() + packet->length(), pos, len);
+      packet->length(packet->length() + len);
+    }
+  }
+  mysql_rwlock_unlock(&m_lock);
+
+  if (len)
+    hits++;
+  else
+    misses++;
+  return len;
+}
+
+
+void Binlog_dump_cache::append(const char *log_name, my_off_t pos,
+                               const uchar *ev, size_t len, bool verified)
+{
+  const size_t size= size_t(opt_binlog_dump_cache_size);
+  if (!size)
+    return;
+
+  mysql_rwlock_wrlock(&m_lock);
+
+  if (size != m_size)
+  {
+    /* binlog_dump_cache_size was changed */
+    my_free(m_buf);
+    m_buf= (uchar*) my_malloc(PSI_INSTRUMENT_ME, size, MYF(0));
+    m_size= m_buf ? size : 0;
+    m_log_name[0]= 0;
+    m_start= m_end= 0;
+    if (!m_size)
+      goto func_exit;
+  }
+
+  bool reset;
+  if (!m_log_name[0] || strcmp(log_name, m_log_name))
+  {
+    /* A slave that is reading an older binary log must not evict the
+    events that the other slaves are about to read. */
+    if (m_log_name[0] && compare_log_name(log_name, m_log_name) < 0)
+      goto func_exit;
+    reset= true;
+  }
+  else if (pos < m_end)
+    /* The event is cached, or the slave is behind the others */
+    goto func_exit;
+  else
+    reset= pos > m_end || (verified && !m_verified);
+
+  if (reset)
+  {
+    strmake_buf(m_log_name, log_name);
+    m_start= m_end= pos;
+    m_verified= verified;
+  }
+
+  if (len > m_size)
+  {
+    /* The event does not fit; continue after it */
+    m_start= m_end= pos + len;
+    goto func_exit;
+  }
+
+  {
+    const size_t offset= size_t(pos % m_size);
+    const size_t n= MY_MIN(len, m_size - offset);
+    memcpy(m_buf + offset, ev, n);
+    memcpy(m_buf, ev + n, len - n);
+  }
+
+  m_end= pos + len;
+  if (m_end - m_start > m_size)
+    m_start= m_end - m_size;
+  m_verified&= verified;
+
+func_exit:
+  mysql_rwlock_unlock(&m_lock);
+}
+
+
+void Binlog_dump_cache::clear()
+{
+  mysql_rwlock_wrlock(&m_lock);
+  if (!opt_binlog_dump_cache_size)
+  {
+    my_free(m_buf);
+    m_buf= NULL;
+    m_size= 0;
+  }
+  m_log_name[0]= 0;
+  m_start= m_end= 0;
+  mysql_rwlock_unlock(&m_lock);
+}
+
+#endif /* HAVE_REPLICATION */
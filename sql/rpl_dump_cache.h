@@ -0,0 +1,113 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef RPL_DUMP_CACHE_INCLUDED
+#define RPL_DUMP_CACHE_INCLUDED
+
+#include "mariadb.h"
+#include "my_sys.h"
+#include "my_counter.h"
+#include "mysql/psi/mysql_thread.h"
+
+class String;
+
+/*
+  Binary log events that are shared by the binlog dump threads
+  (binlog_dump_cache_size)
+
+  Each dump thread reads the binary log on its own. It reads every
+  event from the file, decrypts it, and may verify its checksum
+  (master_verify_checksum). All slaves that have caught up read the
+  same events at the end of the active binary log, so this work is
+  repeated for every slave.
+
+  Binlog_dump_cache keeps the most recently read events of one binary
+  log file in a ring buffer, as the contiguous range [m_start, m_end)
+  of the file. The first dump thread that reads the event at m_end
+  appends it. The other dump threads copy the event from the buffer
+  and do not read the file. The events are stored after decryption and
+  checksum verification, so this is done only once for each event.
+*/
+
+class Binlog_dump_cache
+{
+public:
+  void init();
+  void destroy();
+
+  /*
+    Copy a cached event.
+
+    @param log_name  binary log file name
+    @param pos       start position of the event
+    @param end_pos   the event must end at or before this position
+    @param verified  whether the checksum of the event must have been
+                     verified
+    @param packet    the event is appended to this
+
+    @return the length of the event
+    @retval 0 if the event is not cached; packet was not modified
+  */
+  size_t read(const char *log_name, my_off_t pos, my_off_t end_pos,
+              bool verified, String *packet);
+
+  /*
+    Add an event that was read from the binary log.
+
+    @param log_name  binary log file name
+    @param pos       start position of the event
+    @param ev        the event
+    @param len       length of the event
+    @param verified  whether the checksum of the event was verified
+  */
+  void append(const char *log_name, my_off_t pos, const uchar *ev,
+              size_t len, bool verified);
+
+  /*
+    Discard all events, for RESET MASTER. Free the memory if
+    binlog_dump_cache_size=0.
+  */
+  void clear();
+
+  /* Number of events that were copied from the cache */
+  Atomic_counter<ulonglong> hits;
+  /* Number of events that were read from the binary log */
+  Atomic_counter<ulonglong> misses;
+
+private:
+  /* Copy bytes out of the ring buffer */
+  void copy(uchar *to, my_off_t pos, size_t len) const;
+
+  /* protects the members below */
+  mysql_rwlock_t m_lock;
+  /* the ring buffer; the byte at file position p is m_buf[p % m_size] */
+  uchar *m_buf;
+  /* size of m_buf */
+  size_t m_size;
+  /* binary log file name */
+  char m_log_name[FN_REFLEN];
+  /* start of the cached range of the file */
+  my_off_t m_start;
+  /* end of the cached range of the file */
+  my_off_t m_end;
+  /* whether the checksums of all cached events were verified */
+  bool m_verified;
+};
+
+extern Binlog_dump_cache binlog_dump_cache;
+extern ulonglong opt_binlog_dump_cache_size;
+
+#endif /* RPL_DUMP_CACHE_INCLUDED */
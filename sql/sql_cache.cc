@@ -1071,6 +1071,12 @@ Query_cache::insert(THD *thd, Query_cache_tls *query_cache_tls,
 {
   DBUG_ENTER("Query_cache::insert");
 
+  if (query_cache_tls->result_writer)
+  {
+    result_cache.insert(query_cache_tls, packet, length, pkt_nr);
+    DBUG_VOID_RETURN;
+  }
+
   /* First we check if query cache is disable without doing a mutex lock */
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
@@ -1134,6 +1140,8 @@ Query_cache::abort(THD *thd, Query_cache_tls *query_cache_tls)
 {
   DBUG_ENTER("query_cache_abort");
 
+  result_cache.abort(query_cache_tls);
+
   /* See the comment on double-check locking usage above. */
   if (is_disabled() || query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
@@ -1170,6 +1178,12 @@ void Query_cache::end_of_result(THD *thd)
   ulonglong limit_found_rows= thd->limit_found_rows;
   DBUG_ENTER("Query_cache::end_of_result");
 
+  if (query_cache_tls->result_writer)
+  {
+    result_cache.end_of_result(thd);
+    DBUG_VOID_RETURN;
+  }
+
   /* See the comment on double-check locking usage above. */
   if (query_cache_tls->first_query_block == NULL)
     DBUG_VOID_RETURN;
@@ -1377,7 +1391,8 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
 
     See also a note on double-check locking usage above.
   */
-  if (!thd->query_cache_is_applicable || query_cache_size == 0)
+  if (!thd->query_cache_is_applicable ||
+      (query_cache_size == 0 && !thd->query_cache_tls.result_cache_lookup))
   {
     DBUG_PRINT("qcache", ("Query cache not ready"));
     DBUG_VOID_RETURN;
@@ -1411,6 +1426,12 @@ void Query_cache::store_query(THD *thd, TABLE_LIST *tables_used)
   if ((local_tables= is_cacheable(thd, thd->lex, tables_used,
 				  &tables_type)))
   {
+    if (thd->query_cache_tls.result_cache_lookup)
+    {
+      result_cache.store_query(thd, tables_used, tables_type);
+      DBUG_VOID_RETURN;
+    }
+
     NET *net= &thd->net;
     Query_cache_query_flags flags;
     // fill all gaps between fields with 0 to get repeatable key
@@ -1619,7 +1640,7 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
     @retval FALSE On success
     @retval TRUE On error
 */
-static bool
+bool
 send_data_in_chunks(NET *net, const uchar *packet, size_t len)
 {
   /*
@@ -1720,8 +1741,11 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
   size_t tot_length;
   Query_cache_query_flags flags;
   const char *sql, *sql_end, *found_brace= 0;
+  bool use_result_cache= false;
   DBUG_ENTER("Query_cache::send_result_to_client");
 
+  thd->query_cache_tls.result_cache_lookup= false;
+
   /*
     Testing without a lock here is safe: the thing
     we may loose is that the query won't be served from cache, but we
@@ -1729,9 +1753,16 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
 
     See also a note on double-check locking usage above.
   */
-  if (is_disabled() || thd->locked_tables_mode ||
-      thd->variables.query_cache_type == 0)
+  if (thd->locked_tables_mode)
     goto err;
+  if (is_disabled() || thd->variables.query_cache_type == 0 ||
+      query_cache_size == 0)
+  {
+    /* The result cache is used when the query cache is not */
+    if (!result_cache.is_enabled())
+      goto err;
+    use_result_cache= true;
+  }
 
   /*
     The following can only happen for prepared statements that was found
@@ -1875,24 +1906,9 @@ Query_cache::send_result_to_client(THD *thd, char *org_sql, uint query_length)
       goto err;
     }
   }
-  /*
-    Try to obtain an exclusive lock on the query cache. If the cache is
-    disabled or if a full cache flush is in progress, the attempt to
-    get the lock is aborted.
-
-    The TIMEOUT parameter indicate that the lock is allowed to timeout.
-  */
-  if (try_lock(thd, Query_cache::TIMEOUT))
-    goto err;
-
-  if (query_cache_size == 0)
-  {
-    thd->query_cache_is_applicable= 0;            // Query can't be cached
-    goto err_unlock;
-  }
 
   Query_cache_block *query_block;
-  if (thd->variables.query_cache_strip_comments)
+  if (thd->variables.query_cache_strip_comments || use_result_cache)
   {
     if (found_brace)
       sql= found_brace;
@@ -1981,6 +1997,32 @@ def_week_frmt: %zu, in_trans: %d, autocommit: %d",
   memcpy((uchar *)(sql + (tot_length - QUERY_CACHE_FLAGS_SIZE)),
 	 (uchar*) &flags, QUERY_CACHE_FLAGS_SIZE);
 
+  if (use_result_cache)
+  {
+#ifdef WITH_WSREP
+    /* Causal reads are not served from the result cache */
+    if (WSREP_CLIENT(thd) && wsrep_must_sync_wait(thd))
+      goto err;
+#endif /* WITH_WSREP */
+    DBUG_RETURN(result_cache.send_result_to_client(thd, sql, tot_length));
+  }
+
+  /*
+    Try to obtain an exclusive lock on the query cache. If the cache is
+    disabled or if a full cache flush is in progress, the attempt to
+    get the lock is aborted.
+
+    The TIMEOUT parameter indicate that the lock is allowed to timeout.
+  */
+  if (try_lock(thd, Query_cache::TIMEOUT))
+    goto err;
+
+  if (query_cache_size == 0)
+  {
+    thd->query_cache_is_applicable= 0;            // Query can't be cached
+    goto err_unlock;
+  }
+
 #ifdef WITH_WSREP
   bool once_more;
   once_more= true;
@@ -2234,7 +2276,7 @@ void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
 			     my_bool using_transactions)
 {
   DBUG_ENTER("Query_cache::invalidate (table list)");
-  if (is_disabled())
+  if (is_disabled() && !result_cache.is_enabled())
     DBUG_VOID_RETURN;
 
   using_transactions= using_transactions && thd->in_multi_stmt_transaction_mode();
@@ -2264,7 +2306,7 @@ void Query_cache::invalidate(THD *thd, TABLE_LIST *tables_used,
 void Query_cache::invalidate(THD *thd, CHANGED_TABLE_LIST *tables_used)
 {
   DBUG_ENTER("Query_cache::invalidate (changed table list)");
-  if (is_disabled())
+  if (is_disabled() && !result_cache.is_enabled())
     DBUG_VOID_RETURN;
 
   for (; tables_used; tables_used= tables_used->next)
@@ -2293,7 +2335,7 @@ void Query_cache::invalidate_locked_for_write(THD *thd,
                                               TABLE_LIST *tables_used)
 {
   DBUG_ENTER("Query_cache::invalidate_locked_for_write");
-  if (is_disabled())
+  if (is_disabled() && !result_cache.is_enabled())
     DBUG_VOID_RETURN;
 
   for (; tables_used; tables_used= tables_used->next_local)
@@ -2316,7 +2358,7 @@ void Query_cache::invalidate(THD *thd, TABLE *table,
 			     my_bool using_transactions)
 {
   DBUG_ENTER("Query_cache::invalidate (table)");
-  if (is_disabled())
+  if (is_disabled() && !result_cache.is_enabled())
     DBUG_VOID_RETURN;
 
   using_transactions= using_transactions && thd->in_multi_stmt_transaction_mode();
@@ -2334,7 +2376,7 @@ void Query_cache::invalidate(THD *thd, const char *key, size_t  key_length,
 			     my_bool using_transactions)
 {
   DBUG_ENTER("Query_cache::invalidate (key)");
-  if (is_disabled())
+  if (is_disabled() && !result_cache.is_enabled())
    DBUG_VOID_RETURN;
 
   using_transactions= using_transactions && thd->in_multi_stmt_transaction_mode();
@@ -2354,6 +2396,7 @@ void Query_cache::invalidate(THD *thd, const char *key, size_t  key_length,
 void Query_cache::invalidate(THD *thd, const char *db)
 {
   DBUG_ENTER("Query_cache::invalidate (db)");
+  result_cache.invalidate_all();
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -2428,7 +2471,7 @@ void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
 {
   DBUG_ENTER("Query_cache::invalidate_by_MyISAM_filename");
 
-  if (is_disabled())
+  if (is_disabled() && !result_cache.is_enabled())
     DBUG_VOID_RETURN;
 
   /* Calculate the key outside the lock to make the lock shorter */
@@ -2445,6 +2488,7 @@ void Query_cache::invalidate_by_MyISAM_filename(const char *filename)
 void Query_cache::flush()
 {
   DBUG_ENTER("Query_cache::flush");
+  result_cache.flush();
   if (is_disabled())
     DBUG_VOID_RETURN;
 
@@ -3308,6 +3352,10 @@ void Query_cache::invalidate_table(THD *thd, TABLE *table)
 
 void Query_cache::invalidate_table(THD *thd, uchar * key, size_t key_length)
 {
+  result_cache.invalidate_table(key, key_length);
+  if (is_disabled())
+    return;
+
   DEBUG_SYNC(thd, "wait_in_query_cache_invalidate1");
 
   /*
@@ -4161,7 +4209,8 @@ Query_cache::is_cacheable(THD *thd, LEX *lex,
   DBUG_ENTER("Query_cache::is_cacheable");
 
   if (thd->lex->safe_to_cache_query &&
-      (thd->variables.query_cache_type == 1 ||
+      (thd->query_cache_tls.result_cache_lookup ||
+       thd->variables.query_cache_type == 1 ||
        (thd->variables.query_cache_type == 2 &&
         (lex->first_select_lex()->options & OPTION_TO_QUERY_CACHE))) &&
       qc_is_able_to_intercept_result(thd))
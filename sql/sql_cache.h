@@ -18,6 +18,7 @@
 
 #include "hash.h"
 #include "my_base.h"                            /* ha_rows */
+#include "sql_result_cache.h"
 
 class MY_LOCALE;
 struct TABLE_LIST;
@@ -25,6 +26,7 @@ class Time_zone;
 struct LEX;
 struct TABLE;
 typedef struct st_changed_table_list CHANGED_TABLE_LIST;
+typedef struct st_net NET;
 
 /* Query cache */
 
@@ -263,6 +265,14 @@ extern "C"
 }
 extern "C" void query_cache_invalidate_by_MyISAM_filename(const char* filename);
 
+size_t build_normalized_name(char *buff, size_t bufflen,
+                             const char *db, size_t db_len,
+                             const char *table_name, size_t table_len,
+                             size_t suffix_len);
+#ifndef EMBEDDED_LIBRARY
+bool send_data_in_chunks(NET *net, const uchar *packet, size_t len);
+#endif
+
 
 struct Query_cache_memory_bin
 {
@@ -299,6 +309,7 @@ struct Query_cache_memory_bin_step
 
 class Query_cache
 {
+  friend class Result_cache;
 public:
   /* Info */
   size_t query_cache_size, query_cache_limit;
@@ -586,7 +597,8 @@ struct Query_cache_query_flags
   &query_cache_invalidate_by_MyISAM_filename
 /* note the "maybe": it's a read without mutex */
 #define query_cache_maybe_disabled(T)                                 \
-  (T->variables.query_cache_type == 0 || query_cache.query_cache_size == 0)
+  ((T->variables.query_cache_type == 0 ||                             \
+    query_cache.query_cache_size == 0) && !result_cache.is_enabled())
 #define query_cache_is_cacheable_query(L) \
   (((L)->sql_command == SQLCOM_SELECT) && (L)->safe_to_cache_query)
 #else
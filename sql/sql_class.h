@@ -527,6 +527,7 @@ class MY_LOCALE;
 */
 
 struct Query_cache_block;
+struct Result_cache_writer;
 
 struct Query_cache_tls
 {
@@ -540,7 +541,16 @@ struct Query_cache_tls
     first_query_block= first_query_block_arg;
   }
 
-  Query_cache_tls() :first_query_block(NULL) {}
+  /* The result that is being stored in the result cache */
+  Result_cache_writer *result_writer;
+  /* Whether the current statement was looked up in the result cache */
+  bool result_cache_lookup;
+  /* Result cache key of the current statement */
+  uchar result_cache_digest[MD5_HASH_SIZE];
+
+  Query_cache_tls()
+    :first_query_block(NULL), result_writer(NULL), result_cache_lookup(false)
+  {}
 };
 
 /* SIGNAL / RESIGNAL / GET DIAGNOSTICS */
@@ -712,11 +722,14 @@ typedef struct system_variables
   ulong column_compression_zlib_strategy;
   ulong lock_wait_timeout;
   ulong join_cache_level;
+  ulong join_buff_spill_threshold;
   ulong max_allowed_packet;
   ulong max_error_count;
   ulong max_length_for_sort_data;
   ulong max_recursive_iterations;
   ulong max_sort_length;
+  uint  sort_parallel_threads;
+  uint  load_data_parallel_threads;
   ulong max_tmp_tables;
   ulong max_insert_delayed_threads;
   ulong min_examined_row_limit;
@@ -789,6 +802,7 @@ typedef struct system_variables
   my_bool old_mode;
   my_bool old_passwords;
   my_bool big_tables;
+  my_bool tmp_memory_table_blobs;
   my_bool only_standard_compliant_cte;
   my_bool query_cache_strip_comments;
   my_bool sql_log_slow;
@@ -946,6 +960,7 @@ typedef struct system_status_var
   ulong filesort_rows_;
   ulong filesort_scan_count_;
   ulong filesort_pq_sorts_;
+  ulong join_buffer_spills;
   ulong optimizer_join_prefixes_check_calls;
 
   /* Features used */
@@ -3208,8 +3208,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
     the calculated index of the hash entry for the given key  
 */
 
-inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+static inline ulong key_hash_simple(uchar *key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3220,7 +3219,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
+}
+
+inline
+uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+{
+  return key_hash_simple(key, key_len) % hash_entries;
 }
 
 
@@ -3255,6 +3260,33 @@ uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
 }
 
 
+/* 
+  Calculate the hash value of a key
+
+  SYNOPSIS
+    get_hash_value()
+      key             pointer to the key value
+      key_len         key value length
+
+  DESCRIPTION
+    The function calculates the hash value of the given key by the same
+    hash function as the one that is used for the hash table of the join
+    buffer, but it does not take the value modulo the number of hash entries.
+    So the value can be used to distribute the keys over partitions
+    independently of the hash table.
+
+  RETURN VALUE
+    the calculated hash value of the given key
+*/
+
+ulong JOIN_CACHE_HASHED::get_hash_value(uchar *key, uint key_len)
+{
+  if (hash_func == &JOIN_CACHE_HASHED::get_hash_idx_complex)
+    return key_hashnr(ref_key_info, ref_used_key_parts, key);
+  return key_hash_simple(key, key_len);
+}
+
+
 /* 
   Compare two key entries in the hash table as sequence of bytes
 
@@ -3883,13 +3915,489 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
 {
   DBUG_ENTER("JOIN_CACHE_BNLH::init");
 
-  if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
+  reset_spill();
+
+  if (!(join_tab_scan= new JOIN_TAB_SCAN_BNLH(join, join_tab)))
     DBUG_RETURN(1);
 
   DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
 }
 
 
+/*
+  Add a record into the BNLH join cache buffer
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record calls the
+    function of the parent class. When the join buffer gets full for the
+    first time in the join the function checks whether the join operands
+    can be partitioned. If so, the records of join_tab are written into
+    the partition files during the scan of join_tab that follows.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  bool is_full= JOIN_CACHE_HASHED::put_record();
+  if (is_full && spill_state == SPILL_NONE)
+    spill_state= check_spill_usage() ? SPILL_INNER : SPILL_OFF;
+  return is_full;
+}
+
+
+/*
+  Check whether the operands of the BNLH join can be partitioned
+
+  SYNOPSIS
+    check_spill_usage()
+
+  DESCRIPTION
+    The function checks whether the records of join_tab and the partial
+    join records can be written into partition files as images of their
+    record buffers, and whether the join buffer is expected to be refilled
+    at least join_buffer_spill_threshold times. If so, the function also
+    determines the number of partitions so that a partition of the left
+    operand is expected to fit into the join buffer.
+
+  NOTES
+    The function is called when the join buffer is full, so 'records'
+    is the number of partial join records that fit into it.
+
+  RETURN VALUE
+    TRUE    the join operands are to be partitioned
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::check_spill_usage()
+{
+  JOIN_TAB *tab;
+  ulong threshold= join->thd->variables.join_buff_spill_threshold;
+
+  if (!threshold || prev_cache || next_cache || with_match_flag ||
+      join_tab->bush_root_tab || join_tab->first_inner ||
+      join_tab->emb_sj_nest || join_tab->use_quick == 2 ||
+      join_tab->keep_current_rowid || join_tab->table->s->blob_fields ||
+      start_tab != join->join_tab + join->const_tables)
+    return FALSE;
+
+  for (tab= start_tab; tab != join_tab; tab++)
+  {
+    TABLE *table= tab->table;
+    if (tab->bush_children || tab->first_inner || tab->emb_sj_nest ||
+        tab->keep_current_rowid || table->maybe_null ||
+        table->s->blob_fields)
+      return FALSE;
+  }
+
+  /*
+    A FirstMatch after join_tab sets join->return_tab to cut the
+    enumeration of the extensions of a partial join record. Do not
+    change the order in which these extensions are generated.
+  */
+  for (tab= join_tab+1; tab < join->join_tab+join->top_join_tab_count; tab++)
+  {
+    if (tab->do_firstmatch)
+      return FALSE;
+  }
+
+  double outer_records= (join_tab-1)->get_partial_join_cardinality();
+  if (outer_records < (double) threshold * records)
+    return FALSE;
+  spill_parts= (uint) MY_MIN(MY_MAX(2 * outer_records / records, 4.0),
+                             (double) MAX_SPILL_PARTS);
+  return TRUE;
+}
+
+
+/*
+  Create the partition files of the BNLH join cache
+
+  SYNOPSIS
+    open_spill_parts()
+
+  DESCRIPTION
+    The function creates spill_parts partition files for each of the
+    join operands. The files get their disk space only when the data
+    written into them does not fit into their buffers.
+
+  RETURN VALUE
+    FALSE   the files have been created
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::open_spill_parts()
+{
+  DBUG_ASSERT(!inner_parts);
+  if (!(inner_parts= (IO_CACHE *) my_malloc(key_memory_JOIN_CACHE,
+                                           2*spill_parts*sizeof(IO_CACHE),
+                                           MYF(MY_WME | MY_ZEROFILL))))
+    return TRUE;
+  outer_parts= inner_parts+spill_parts;
+  for (uint i= 0; i < 2*spill_parts; i++)
+  {
+    if (open_cached_file(inner_parts+i, mysql_tmpdir, TEMP_PREFIX,
+                         SPILL_BUFFER_SIZE, MYF(MY_WME)))
+    {
+      free_spill_parts();
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+
+/*
+  Delete the partition files of the BNLH join cache, if there are any
+*/
+
+void JOIN_CACHE_BNLH::free_spill_parts()
+{
+  if (!inner_parts)
+    return;
+  for (uint i= 0; i < 2*spill_parts; i++)
+    close_cached_file(inner_parts+i);
+  my_free(inner_parts);
+  inner_parts= outer_parts= 0;
+}
+
+
+/*
+  Get the number of the partition for a join key value
+
+  SYNOPSIS
+    get_spill_part()
+      key    the key value
+
+  DESCRIPTION
+    The function maps the hash value of the key to a partition number.
+    The high bits of the product with a large odd constant are used
+    so that the partition number does not depend on the number of the
+    hash entry for the key in the join buffer. Otherwise the keys of
+    a partition would fill only a fraction of the hash table.
+
+  RETURN VALUE
+    the number of the partition
+*/
+
+uint JOIN_CACHE_BNLH::get_spill_part(uchar *key)
+{
+  ulonglong nr= (ulonglong) get_hash_value(key, key_length);
+  return (uint) (((nr * 0x9E3779B97F4A7C15ULL) >> 32) % spill_parts);
+}
+
+
+/*
+  Write the current record of join_tab into its partition file
+
+  SYNOPSIS
+    spill_inner_record()
+
+  RETURN VALUE
+    FALSE   the record has been written
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_inner_record()
+{
+  TABLE *table= join_tab->table;
+  KEY *keyinfo= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
+  key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+  return my_b_write(inner_parts+get_spill_part(key_buff), table->record[0],
+                    table->s->reclength) != 0;
+}
+
+
+/*
+  Read the next record of join_tab from the current partition file
+
+  SYNOPSIS
+    read_spilled_inner_record()
+
+  RETURN VALUE
+    0     the record has been read into the record buffer of join_tab
+    -1    there are no more records in the partition
+    1     an error occurred
+*/
+
+int JOIN_CACHE_BNLH::read_spilled_inner_record()
+{
+  TABLE *table= join_tab->table;
+  IO_CACHE *part= inner_parts+curr_spill_part;
+  if (my_b_read(part, table->record[0], table->s->reclength))
+    return part->error ? 1 : -1;
+  table->status= 0;
+  table->null_row= 0;
+  return 0;
+}
+
+
+/*
+  Write the current partial join record into a partition file
+
+  SYNOPSIS
+    spill_record()
+
+  DESCRIPTION
+    This implementation of the virtual function spill_record builds the
+    join key over the fields of the record buffers like put_record does,
+    and writes the record buffers of all tables whose fields can be stored
+    in the join buffer into the partition file for this key.
+
+  RETURN VALUE
+    FALSE   the record has been written
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_record()
+{
+  TABLE_REF *ref= &join_tab->ref;
+  IO_CACHE *part;
+
+  cp_buffer_from_ref(join->thd, join_tab->table, ref);
+  part= outer_parts+get_spill_part(ref->key_buff);
+  for (JOIN_TAB *tab= start_tab; tab != join_tab; tab++)
+  {
+    TABLE *table= tab->table;
+    if (my_b_write(part, table->record[0], table->s->reclength))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Read the next partial join record from a partition file
+
+  SYNOPSIS
+    read_spilled_record()
+      part    the partition file
+
+  DESCRIPTION
+    The function restores the record buffers of the tables whose fields
+    can be stored in the join buffer from the partition file.
+
+  RETURN VALUE
+    FALSE   the record has been read
+    TRUE    there are no more records in the partition, or an error occurred
+*/
+
+bool JOIN_CACHE_BNLH::read_spilled_record(IO_CACHE *part)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab; tab++)
+  {
+    TABLE *table= tab->table;
+    if (my_b_read(part, table->record[0], table->s->reclength))
+      return TRUE;
+    table->status= 0;
+    table->null_row= 0;
+  }
+  return FALSE;
+}
+
+
+/*
+  Join the partitions of the BNLH join operands
+
+  SYNOPSIS
+    join_spilled_records()
+      rc    the result of the last call of join_records
+
+  DESCRIPTION
+    This implementation of the virtual function join_spilled_records joins
+    the partitions with the same number pairwise when all partial join
+    records have been received. The partial join records of a partition
+    are put into the join buffer. Each time the buffer gets full, and
+    after the last record of the partition, the function join_records
+    is called. It reads the records of join_tab from the matching
+    partition file rather than from the table.
+    A join key can match only keys from the partition with the same number.
+    As only inner joins are partitioned, a pair of partitions is skipped
+    if any of them is empty.
+    Finally the partition files are deleted.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state
+JOIN_CACHE_BNLH::join_spilled_records(enum_nested_loop_state rc)
+{
+  DBUG_ENTER("JOIN_CACHE_BNLH::join_spilled_records");
+
+  if (spill_state == SPILL_OUTER &&
+      (rc == NESTED_LOOP_OK || rc == NESTED_LOOP_NO_MORE_ROWS))
+  {
+    spill_state= SPILL_JOIN;
+    for (curr_spill_part= 0; curr_spill_part < spill_parts; curr_spill_part++)
+    {
+      IO_CACHE *part= outer_parts+curr_spill_part;
+      if (!my_b_tell(part) || !my_b_tell(inner_parts+curr_spill_part))
+        continue;
+      if (reinit_io_cache(part, READ_CACHE, 0L, 0, 0))
+      {
+        rc= NESTED_LOOP_ERROR;
+        goto finish;
+      }
+      while (!read_spilled_record(part))
+      {
+        if (unlikely(join->thd->check_killed()))
+        {
+          rc= NESTED_LOOP_KILLED;
+          goto finish;
+        }
+        if (put_record())
+        {
+          rc= join_records(FALSE);
+          if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+            goto finish;
+        }
+      }
+      if (part->error)
+      {
+        rc= NESTED_LOOP_ERROR;
+        goto finish;
+      }
+      rc= join_records(FALSE);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        goto finish;
+    }
+  }
+
+finish:
+  free_spill_parts();
+  spill_state= SPILL_NONE;
+  DBUG_RETURN(rc);
+}
+
+
+/* 
+  Initiate an iteration process over records of the table joined by BNLH
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    When the partitions of the join operands are joined the function
+    prepares reading the records of join_tab from the current partition.
+    Otherwise it initiates the iteration over the table by calling the
+    function of the parent class. If the records of join_tab are to be
+    partitioned the function creates the partition files first.
+
+  RETURN VALUE   
+    0            the initiation is a success 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_BNLH::open()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+
+  eof= FALSE;
+  if (bnlh->spill_state == JOIN_CACHE_BNLH::SPILL_JOIN)
+  {
+    save_or_restore_used_tabs(join_tab, FALSE);
+    join_tab->tracker->r_scans++;
+    return reinit_io_cache(bnlh->inner_parts+bnlh->curr_spill_part,
+                           READ_CACHE, 0L, 0, 0);
+  }
+  if (bnlh->spill_state == JOIN_CACHE_BNLH::SPILL_INNER &&
+      bnlh->open_spill_parts())
+    return 1;
+  return JOIN_TAB_SCAN::open();
+}
+
+
+/* 
+  Read the next record that can match while scanning the table joined by BNLH
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    When the partitions of the join operands are joined the function
+    reads the next record of join_tab from the current partition file.
+    Otherwise it calls the function of the parent class. If the records
+    of join_tab are being partitioned the read record is also written
+    into its partition file.
+
+  RETURN VALUE   
+    0            the next record exists and has been successfully read 
+    error code   otherwise     
+*/
+
+int JOIN_TAB_SCAN_BNLH::next()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+  int err;
+
+  switch (bnlh->spill_state) {
+  case JOIN_CACHE_BNLH::SPILL_JOIN:
+    if (!(err= bnlh->read_spilled_inner_record()))
+    {
+      join_tab->tracker->r_rows++;
+      join_tab->tracker->r_rows_after_where++;
+    }
+    return err;
+  case JOIN_CACHE_BNLH::SPILL_INNER:
+    if ((err= JOIN_TAB_SCAN::next()))
+    {
+      eof= err < 0;
+      return err;
+    }
+    return bnlh->spill_inner_record() ? 1 : 0;
+  default:
+    return JOIN_TAB_SCAN::next();
+  }
+}
+
+
+/* 
+  Perform finalizing actions for a scan over the table joined by BNLH
+
+  SYNOPSIS
+    close()
+
+  DESCRIPTION
+    The function calls the function of the parent class. If the records
+    of join_tab have been partitioned during this scan, then the partial
+    join records are to be partitioned from now on. However, if the scan
+    has not reached the end of the table, the partitions are incomplete.
+    In this case they are deleted, and the join is finished without
+    partitioning.
+
+  RETURN VALUE   
+    none      
+*/
+
+void JOIN_TAB_SCAN_BNLH::close()
+{
+  JOIN_CACHE_BNLH *bnlh= (JOIN_CACHE_BNLH *) cache;
+
+  JOIN_TAB_SCAN::close();
+  if (bnlh->spill_state == JOIN_CACHE_BNLH::SPILL_INNER)
+  {
+    if (eof)
+    {
+      bnlh->spill_state= JOIN_CACHE_BNLH::SPILL_OUTER;
+      status_var_increment(join->thd->status_var.join_buffer_spills);
+    }
+    else
+    {
+      bnlh->free_spill_parts();
+      bnlh->spill_state= JOIN_CACHE_BNLH::SPILL_OFF;
+    }
+  }
+  eof= FALSE;
+}
+
+
 /* 
   Calculate the increment of the MRR buffer for a record write       
 
@@ -673,6 +673,26 @@ class JOIN_CACHE :public Sql_alloc
   /* Join records from the join buffer with records from the next join table */ 
   enum_nested_loop_state join_records(bool skip_last);
 
+  /* 
+    Shall return TRUE if the partial join records are to be written into
+    partition files on disk instead of the join buffer
+  */
+  virtual bool is_spilled() { return FALSE; }
+
+  /* Shall write the current partial join record into a partition file */
+  virtual bool spill_record() { DBUG_ASSERT(0); return TRUE; }
+
+  /* 
+    Shall join the partial join records from the partition files with
+    the records from the next join table and release the partition files.
+    Here rc is the result of the last call of join_records().
+  */
+  virtual enum_nested_loop_state
+    join_spilled_records(enum_nested_loop_state rc) { return rc; }
+
+  /* Discard the partitions of an unfinished join, if there are any */
+  virtual void reset_spill() {}
+
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
 
@@ -680,7 +700,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() {}
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -984,6 +1004,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Search for a key in the hash table of the join buffer */
   bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
 
+  /* Get the hash value of a key regardless of the size of the hash table */
+  ulong get_hash_value(uchar *key, uint key_len);
+
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer();
 
@@ -1098,6 +1121,33 @@ class JOIN_TAB_SCAN: public Sql_alloc
 
 };
 
+/*
+  The class JOIN_TAB_SCAN_BNLH is a companion class for the class
+  JOIN_CACHE_BNLH. In addition to the iteration over the joined table
+  that is performed by JOIN_TAB_SCAN it can write the records of the table
+  into the partition files of the join cache, or read the records
+  of the table from one of these files instead of the table.
+*/
+
+class JOIN_TAB_SCAN_BNLH: public JOIN_TAB_SCAN
+{
+private:
+  /* TRUE if all records of the joined table have been read */
+  bool eof;
+
+public:
+
+  JOIN_TAB_SCAN_BNLH(JOIN *j, JOIN_TAB *tab)
+    :JOIN_TAB_SCAN(j, tab), eof(FALSE) {}
+
+  int open();
+
+  int next();
+
+  void close();
+
+};
+
 /*
   The class JOIN_CACHE_BNL is used when the BNL join algorithm is
   employed to perform a join operation   
@@ -1154,6 +1204,23 @@ class JOIN_CACHE_BNL :public JOIN_CACHE
 /*
   The class JOIN_CACHE_BNLH is used when the BNLH join algorithm is
   employed to perform a join operation   
+
+  When the left join operand does not fit into the join buffer the
+  BNLH algorithm has to scan join_tab once for every refill of the buffer.
+  To avoid this the cache can switch to a hybrid hash join. While join_tab
+  is scanned for the first full join buffer its records are also written
+  into partition files by the hash value of their join keys. After this
+  the remaining partial join records are not put into the join buffer but
+  written into partition files of the left operand by the same hash value.
+  When all partial join records have been received the partitions with
+  the same number are joined pairwise by the usual BNLH algorithm, where
+  the records of join_tab are read from the partition file instead of
+  the table. So join_tab is scanned only once, and each record of it is
+  read back from disk about as many times as the join buffer has to be
+  refilled for a partition of the left operand.
+  The partitions contain images of the record buffers. That is why this
+  is done only for inner joins of tables without blobs that are not
+  linked with other join caches.
 */
 
 class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
@@ -1190,6 +1257,51 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr);
 
+private:
+
+  /* The maximum number of partitions of each join operand */
+  static const uint MAX_SPILL_PARTS= 64;
+  /* The size of the buffer of a partition file */
+  static const size_t SPILL_BUFFER_SIZE= 4*IO_SIZE;
+
+  /* 
+    The states of the partitioning of the join operands:
+    SPILL_NONE   the records are joined by the usual BNLH algorithm
+    SPILL_INNER  the records of join_tab read for the current join buffer
+                 are written into the partitions of the right operand
+    SPILL_OUTER  the partial join records are written into the partitions
+                 of the left operand rather than into the join buffer
+    SPILL_JOIN   the partitions are being joined pairwise
+    SPILL_OFF    the partitioning cannot be used until the join is finished
+  */
+  enum Spill_state { SPILL_NONE, SPILL_INNER, SPILL_OUTER, SPILL_JOIN,
+                     SPILL_OFF };
+  Spill_state spill_state;
+
+  /* The number of partitions of each join operand */
+  uint spill_parts;
+  /* The partition files for the records of join_tab (the right operand) */
+  IO_CACHE *inner_parts;
+  /* The partition files for the partial join records (the left operand) */
+  IO_CACHE *outer_parts;
+  /* The number of the partition that is being joined in SPILL_JOIN state */
+  uint curr_spill_part;
+
+  /* Check whether both join operands can be partitioned */
+  bool check_spill_usage();
+  /* Create the partition files */
+  bool open_spill_parts();
+  /* Delete the partition files */
+  void free_spill_parts();
+  /* Get the number of the partition for a key value */
+  uint get_spill_part(uchar *key);
+  /* Write the record of join_tab into its partition */
+  bool spill_inner_record();
+  /* Read the next record of join_tab from the current partition */
+  int read_spilled_inner_record();
+  /* Read the next partial join record from a partition */
+  bool read_spilled_record(IO_CACHE *part);
+
 public:
 
   /* 
@@ -1197,7 +1309,9 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_state(SPILL_NONE),
+      spill_parts(0), inner_parts(0), outer_parts(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,7 +1320,8 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_state(SPILL_NONE),
+      spill_parts(0), inner_parts(0), outer_parts(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain);
@@ -1215,6 +1330,28 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   bool is_key_access() { return TRUE; }
 
+  bool put_record();
+
+  bool is_spilled() { return spill_state == SPILL_OUTER; }
+
+  bool spill_record();
+
+  enum_nested_loop_state join_spilled_records(enum_nested_loop_state rc);
+
+  void reset_spill()
+  {
+    free_spill_parts();
+    spill_state= SPILL_NONE;
+  }
+
+  void free()
+  {
+    reset_spill();
+    JOIN_CACHE_HASHED::free();
+  }
+
+  friend class JOIN_TAB_SCAN_BNLH;
+
 };
 
 
@@ -45,6 +45,9 @@
 #include "wsrep_mysqld.h"
 
 #include "scope.h"  // scope_exit
+#include "sql_parallel.h"
+#include "sql_array.h"
+#include <vector>
 
 extern "C" int _my_b_net_read(IO_CACHE *info, uchar *Buffer, size_t Count);
 
@@ -101,6 +104,24 @@ class Term_string
 #define GET (stack_pos != stack ? *--stack_pos : my_b_get(&cache))
 #define PUSH(A) *(stack_pos++)=(A)
 
+
+/* Unescape all escape characters */
+
+static inline char unescape_char(char chr)
+{
+  /* keep this switch synchornous with the ESCAPE_CHARS macro */
+  switch(chr) {
+  case 'n': return '\n';
+  case 't': return '\t';
+  case 'r': return '\r';
+  case 'b': return '\b';
+  case '0': return 0;				// Ascii null
+  case 'Z': return '\032';			// Win32 end of file
+  default:  return chr;
+  }
+}
+
+
 #ifdef WITH_WSREP
 /** If requested by wsrep_load_data_splitting and streaming replication is
     not enabled, replicate a streaming fragment every 10,000 rows.*/
@@ -139,6 +160,7 @@ class Wsrep_load_data_split
 
 class READ_INFO: public Load_data_param
 {
+  friend class Load_data_parser;
   File	file;
   String data;                          /* Read buffer */
   Term_string m_field_term;             /* FIELDS TERMINATED BY 'string' */
@@ -241,6 +263,8 @@ class READ_INFO: public Load_data_param
   bool terminator(int chr, const Term_string &str)
   { return str.initial_byte() == chr && terminator(str); }
   bool find_start_of_fields();
+  bool can_split_lines() const;
+  size_t read_block(uchar *to, size_t length);
   /* load xml */
   List<XML_TAG> taglist;
   int read_value(int delim, String *val);
@@ -270,6 +294,13 @@ static int read_sep_field(THD *thd, COPY_INFO &info, TABLE_LIST *table_list,
                           List<Item> &set_values, READ_INFO &read_info,
 			  String &enclosed, ulong skip_lines,
 			  bool ignore_check_option_errors);
+static int read_sep_field_parallel(THD *thd, COPY_INFO &info,
+                                   TABLE_LIST *table_list,
+                                   List<Item> &fields_vars,
+                                   List<Item> &set_fields,
+                                   List<Item> &set_values,
+                                   READ_INFO &read_info, ulong skip_lines,
+                                   bool ignore_check_option_errors);
 
 static int read_xml_field(THD *thd, COPY_INFO &info, TABLE_LIST *table_list,
                           List<Item> &fields_vars, List<Item> &set_fields,
@@ -1079,6 +1110,13 @@ read_sep_field(THD *thd, COPY_INFO &info, TABLE_LIST *table_list,
   ulonglong counter, time_to_report_progress;
   DBUG_ENTER("read_sep_field");
 
+  if (thd->variables.load_data_parallel_threads > 1 &&
+      fields_vars.elements && read_info.can_split_lines())
+    DBUG_RETURN(read_sep_field_parallel(thd, info, table_list, fields_vars,
+                                        set_fields, set_values, read_info,
+                                        skip_lines,
+                                        ignore_check_option_errors));
+
   enclosed_length=enclosed.length();
 
   counter= 0;
@@ -1207,6 +1245,592 @@ continue_loop:;
 }
 
 
+/*
+  Parallel parsing of LOAD DATA input (load_data_parallel_threads)
+
+  The session thread reads the input in chunks that end at a line
+  terminator. Parallel_tasks split the lines of each chunk into fields
+  and unescape the fields in place. The session thread also parses
+  chunks while it waits, so that it does not depend on the pool threads,
+  which may be busy with other statements. The session thread stores the
+  fields and writes the rows in the order of the input, because neither
+  the Items nor the handler are thread-safe.
+
+  This is only possible if a line terminator that is found in the middle
+  of the input is known to end a line; see READ_INFO::can_split_lines().
+  The fields are then the same as READ_INFO::read_field() would read.
+*/
+
+class Load_data_parser
+{
+public:
+  /* A field of a line */
+  struct field_t
+  {
+    /* start of the unescaped value in chunk_t::buf */
+    size_t offset;
+    /* length of the unescaped value */
+    size_t length;
+    /* whether the value is \N */
+    bool null;
+  };
+
+  /* A line of input */
+  struct row_t
+  {
+    /* index of the first field in chunk_t::fields */
+    size_t first_field;
+    /* number of fields that were read */
+    uint n_fields;
+    /* whether the line has more fields than were read */
+    bool cut;
+  };
+
+  /* Lines of input */
+  struct chunk_t
+  {
+    chunk_t()
+      : buf(NULL), length(0), alloced(0),
+        fields(key_memory_Load_data_parser, 1024, 1024),
+        rows(key_memory_Load_data_parser, 256, 256)
+    {}
+
+    /* the input; one byte after the input is reserved for an end marker */
+    uchar *buf;
+    /* size of the input, ending in a line terminator or at end of file */
+    size_t length;
+    /* size of buf */
+    size_t alloced;
+    /* position of the end of the chunk in the input */
+    my_off_t end_pos;
+    /* the fields of all lines */
+    Dynamic_array<field_t> fields;
+    /* the lines */
+    Dynamic_array<row_t> rows;
+    /* whether fields and rows are valid */
+    bool parsed;
+    /* whether memory could not be allocated for fields or rows */
+    bool oom;
+  };
+
+  Load_data_parser(READ_INFO &read_info, uint max_fields, uint n_threads);
+  ~Load_data_parser();
+
+  /*
+    Get the next chunk. The chunk that was returned by the previous call
+    is released.
+
+    @return the parsed chunk
+    @retval NULL at end of file, or on error if read_info.error was set
+  */
+  chunk_t *next_chunk();
+
+private:
+  /* Size of a chunk, unless a line is longer than this */
+  static constexpr size_t CHUNK_SIZE= 256 * 1024;
+
+  bool fill(chunk_t *chunk);
+  size_t split(const uchar *buf, size_t start, size_t length) const;
+  bool line_term(const uchar *buf, size_t pos, size_t length) const;
+  bool field_term(const uchar *buf, size_t pos, size_t length) const;
+  void parse(chunk_t *chunk) const;
+  void parse_claimed();
+  void worker();
+  static void worker_callback(void *arg)
+  { static_cast<Load_data_parser*>(arg)->worker(); }
+
+  READ_INFO &m_read_info;
+  /* number of fields to read from a line */
+  const uint m_max_fields;
+  /* maximum number of concurrent tasks */
+  const uint m_max_workers;
+  /* ring buffer of chunks; chunk i is m_chunks[i % m_chunks.size()] */
+  std::vector<chunk_t> m_chunks;
+  Parallel_tasks m_workers;
+  /* the tail of the input after the last chunk that was filled */
+  uchar *m_carry;
+  size_t m_carry_length;
+  size_t m_carry_alloced;
+  /* whether the end of the input was reached */
+  bool m_eof;
+  /* whether the chunk m_consumed was returned by next_chunk() */
+  bool m_current;
+
+  /* protects the members below */
+  mysql_mutex_t m_mutex;
+  /* signalled when a chunk was parsed */
+  mysql_cond_t m_done;
+  /* number of chunks that were filled */
+  ulonglong m_read;
+  /* number of chunks that were claimed for parsing */
+  ulonglong m_claimed;
+  /* number of chunks that were released by the session thread */
+  ulonglong m_consumed;
+  /* number of tasks that were submitted and have not finished */
+  uint m_running;
+};
+
+
+Load_data_parser::Load_data_parser(READ_INFO &read_info, uint max_fields,
+                                   uint n_threads)
+  : m_read_info(read_info), m_max_fields(max_fields),
+    m_max_workers(n_threads - 1), m_chunks(2 * n_threads),
+    m_workers(worker_callback, this), m_carry(NULL), m_carry_length(0),
+    m_carry_alloced(0), m_eof(false), m_current(false),
+    m_read(0), m_claimed(0), m_consumed(0), m_running(0)
+{
+  mysql_mutex_init(key_LOCK_load_data_parser, &m_mutex, MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_load_data_parser, &m_done, NULL);
+}
+
+
+Load_data_parser::~Load_data_parser()
+{
+  /* The tasks must not access the chunks any more */
+  m_workers.wait();
+  DBUG_ASSERT(!m_running);
+  for (chunk_t &chunk : m_chunks)
+    my_free(chunk.buf);
+  my_free(m_carry);
+  mysql_cond_destroy(&m_done);
+  mysql_mutex_destroy(&m_mutex);
+}
+
+
+inline bool Load_data_parser::line_term(const uchar *buf, size_t pos,
+                                        size_t length) const
+{
+  const Term_string &term= m_read_info.m_line_term;
+  return buf[pos] == term.initial_byte() && pos + term.length() <= length &&
+    !memcmp(buf + pos, term.ptr(), term.length());
+}
+
+
+inline bool Load_data_parser::field_term(const uchar *buf, size_t pos,
+                                         size_t length) const
+{
+  const Term_string &term= m_read_info.m_field_term;
+  return buf[pos] == term.initial_byte() && pos + term.length() <= length &&
+    !memcmp(buf + pos, term.ptr(), term.length());
+}
+
+
+/*
+  Find the end of the last line in a buffer.
+
+  @param buf     input that starts at the start of a line
+  @param start   the line terminator must end after this
+  @param length  size of the input
+
+  @return the end of the last line terminator
+  @retval 0 if no line terminator was found
+*/
+
+size_t Load_data_parser::split(const uchar *buf, size_t start,
+                               size_t length) const
+{
+  const uint term_length= m_read_info.m_line_term.length();
+  for (size_t end= length; end > start && end >= term_length; end--)
+  {
+    const size_t pos= end - term_length;
+    if (!line_term(buf, pos, length))
+      continue;
+    /* The terminator is escaped if it follows an odd number of escapes */
+    size_t escapes= pos;
+    while (escapes && buf[escapes - 1] == m_read_info.escape_char)
+      escapes--;
+    if (!((pos - escapes) & 1))
+      return end;
+  }
+  return 0;
+}
+
+
+/*
+  Read the next chunk of input.
+
+  @return whether there was any input
+*/
+
+bool Load_data_parser::fill(chunk_t *chunk)
+{
+  size_t length= m_carry_length, end= 0, scanned= 0;
+
+  if (chunk->alloced < length + CHUNK_SIZE + 1)
+  {
+    const size_t alloced= length + CHUNK_SIZE + 1;
+    uchar *buf= (uchar*) my_realloc(key_memory_Load_data_parser,
+                                    chunk->buf, alloced,
+                                    MYF(MY_WME | MY_ALLOW_ZERO_PTR |
+                                        MY_THREAD_SPECIFIC));
+    if (!buf)
+      goto err;
+    chunk->buf= buf;
+    chunk->alloced= alloced;
+  }
+  if (length)
+    memcpy(chunk->buf, m_carry, length);
+
+  while (!end)
+  {
+    if (chunk->alloced - 1 - length < IO_SIZE)
+    {
+      /* A line is longer than the chunk */
+      const size_t alloced= chunk->alloced * 2;
+      uchar *buf= (uchar*) my_realloc(key_memory_Load_data_parser,
+                                      chunk->buf, alloced,
+                                      MYF(MY_WME | MY_THREAD_SPECIFIC));
+      if (!buf)
+        goto err;
+      chunk->buf= buf;
+      chunk->alloced= alloced;
+    }
+    const size_t n= m_read_info.read_block(chunk->buf + length,
+                                           chunk->alloced - 1 - length);
+    if (!n)
+    {
+      if (m_read_info.error)
+        goto err;
+      m_eof= true;
+      end= length;
+      break;
+    }
+    length+= n;
+    if (length >= CHUNK_SIZE)
+    {
+      end= split(chunk->buf, scanned, length);
+      /* Do not search the same bytes again */
+      scanned= length;
+    }
+  }
+
+  m_carry_length= length - end;
+  if (m_carry_length)
+  {
+    if (m_carry_alloced < m_carry_length)
+    {
+      my_free(m_carry);
+      if (!(m_carry= (uchar*) my_malloc(key_memory_Load_data_parser,
+                                        m_carry_length,
+                                        MYF(MY_WME | MY_THREAD_SPECIFIC))))
+      {
+        m_carry_alloced= m_carry_length= 0;
+        goto err;
+      }
+      m_carry_alloced= m_carry_length;
+    }
+    memcpy(m_carry, chunk->buf + end, m_carry_length);
+  }
+  chunk->length= end;
+  chunk->end_pos= m_read_info.position() - m_carry_length;
+  return end != 0;
+
+err:
+  m_read_info.error= 1;
+  m_eof= true;
+  return false;
+}
+
+
+/*
+  Split a chunk into lines and fields, like READ_INFO::read_field()
+  and READ_INFO::next_line().
+*/
+
+void Load_data_parser::parse(chunk_t *chunk) const
+{
+  uchar *buf= chunk->buf;
+  const size_t length= chunk->length;
+  const int escape_char= m_read_info.escape_char;
+  const uint line_term_length= m_read_info.m_line_term.length();
+  const uint field_term_length= m_read_info.m_field_term.length();
+  size_t pos= 0;
+
+  chunk->fields.clear();
+  chunk->rows.clear();
+  chunk->oom= false;
+
+  while (pos < length)
+  {
+    row_t row= { chunk->fields.elements(), 0, false };
+    bool end_of_line= false;
+
+    while (!end_of_line && pos < length)
+    {
+      if (row.n_fields == m_max_fields)
+      {
+        /* Skip the rest of the line */
+        while (pos < length)
+        {
+          if (buf[pos] == escape_char)
+            pos= MY_MIN(pos + 2, length);
+          else if (line_term(buf, pos, length))
+          {
+            pos+= line_term_length;
+            break;
+          }
+          else
+            pos++;
+          row.cut= true;
+        }
+        break;
+      }
+
+      field_t field= { pos, 0, false };
+      uchar *to= buf + pos;
+      while (pos < length)
+      {
+        const uchar chr= buf[pos];
+        if (chr == escape_char)
+        {
+          if (++pos == length)
+            *to++= chr;
+          else
+          {
+            field.null|= buf[pos] == 'N';
+            *to++= (uchar) unescape_char((char) buf[pos++]);
+          }
+        }
+        else if (line_term(buf, pos, length))
+        {
+          pos+= line_term_length;
+          end_of_line= true;
+          break;
+        }
+        else if (field_term(buf, pos, length))
+        {
+          pos+= field_term_length;
+          break;
+        }
+        else
+          *to++= buf[pos++];
+      }
+      field.length= size_t(to - (buf + field.offset));
+      field.null&= field.length == 1;
+      /* This may run in a pool thread, so my_error() must not be called */
+      if (unlikely(chunk->fields.append(field)))
+        goto oom;
+      row.n_fields++;
+    }
+
+    if (unlikely(chunk->rows.append(row)))
+      goto oom;
+  }
+  return;
+
+oom:
+  chunk->oom= true;
+}
+
+
+/* Parse the next chunk that was not claimed by any thread */
+
+void Load_data_parser::parse_claimed()
+{
+  mysql_mutex_assert_owner(&m_mutex);
+  DBUG_ASSERT(m_claimed < m_read);
+  chunk_t *chunk= &m_chunks[m_claimed++ % m_chunks.size()];
+  mysql_mutex_unlock(&m_mutex);
+  parse(chunk);
+  mysql_mutex_lock(&m_mutex);
+  chunk->parsed= true;
+  mysql_cond_broadcast(&m_done);
+}
+
+
+/* Parse chunks in a Parallel_tasks task until none are left */
+
+void Load_data_parser::worker()
+{
+  mysql_mutex_lock(&m_mutex);
+  while (m_claimed < m_read)
+    parse_claimed();
+  DBUG_ASSERT(m_running);
+  m_running--;
+  mysql_mutex_unlock(&m_mutex);
+}
+
+
+Load_data_parser::chunk_t *Load_data_parser::next_chunk()
+{
+  chunk_t *chunk= NULL;
+
+  mysql_mutex_lock(&m_mutex);
+  if (m_current)
+  {
+    m_consumed++;
+    m_current= false;
+  }
+
+  /* Keep all chunks busy */
+  while (!m_eof && m_read - m_consumed < m_chunks.size())
+  {
+    chunk_t *next= &m_chunks[m_read % m_chunks.size()];
+    mysql_mutex_unlock(&m_mutex);
+    const bool filled= fill(next);
+    mysql_mutex_lock(&m_mutex);
+    if (!filled)
+      break;
+    next->parsed= false;
+    m_read++;
+    if (m_running < m_max_workers)
+    {
+      m_running++;
+      m_workers.submit(1);
+    }
+  }
+
+  if (!m_read_info.error && m_consumed != m_read)
+  {
+    chunk= &m_chunks[m_consumed % m_chunks.size()];
+    while (!chunk->parsed)
+    {
+      if (m_claimed < m_read)
+        parse_claimed();
+      else
+        mysql_cond_wait(&m_done, &m_mutex);
+    }
+    m_current= true;
+  }
+  mysql_mutex_unlock(&m_mutex);
+
+  if (chunk && chunk->oom)
+  {
+    my_error(ER_OUT_OF_RESOURCES, MYF(0));
+    m_read_info.error= 1;
+    return NULL;
+  }
+  return chunk;
+}
+
+
+/*
+  Read the lines of LOAD DATA ... FIELDS TERMINATED BY with
+  Load_data_parser, and write the rows like read_sep_field() does.
+*/
+
+static int
+read_sep_field_parallel(THD *thd, COPY_INFO &info, TABLE_LIST *table_list,
+                        List<Item> &fields_vars, List<Item> &set_fields,
+                        List<Item> &set_values, READ_INFO &read_info,
+                        ulong skip_lines, bool ignore_check_option_errors)
+{
+  List_iterator_fast<Item> it(fields_vars);
+  Item *item;
+  TABLE *table= table_list->table;
+  bool err, progress_reports;
+  Load_data_parser::chunk_t *chunk;
+  DBUG_ENTER("read_sep_field_parallel");
+
+  progress_reports= 1;
+  if ((thd->progress.max_counter= read_info.file_length()) == ~(my_off_t) 0)
+    progress_reports= 0;
+
+  Load_data_parser parser(read_info, fields_vars.elements,
+                          thd->variables.load_data_parallel_threads);
+
+  while ((chunk= parser.next_chunk()))
+  {
+    if (progress_reports)
+    {
+      thd->progress.counter= chunk->end_pos;
+      thd_progress_report(thd, thd->progress.counter,
+                          thd->progress.max_counter);
+    }
+
+    for (size_t r= 0; r < chunk->rows.elements(); r++)
+    {
+      const Load_data_parser::row_t &row= chunk->rows.at(r);
+
+      if (thd->killed)
+      {
+        thd->send_kill_message();
+        DBUG_RETURN(1);
+      }
+
+      if (skip_lines)
+      {
+        skip_lines--;
+        continue;
+      }
+
+      restore_record(table, s->default_values);
+      it.rewind();
+
+      const Load_data_parser::field_t *field=
+        chunk->fields.get_pos(row.first_field);
+      for (uint i= 0; i < row.n_fields; i++, field++)
+      {
+        item= it++;
+        Load_data_outvar *dst= item->get_load_data_outvar_or_error();
+        DBUG_ASSERT(dst);
+
+        if (field->null)
+        {
+          if (dst->load_data_set_null(thd, &read_info))
+            DBUG_RETURN(1);
+        }
+        else
+        {
+          char *pos= (char*) chunk->buf + field->offset;
+          pos[field->length]= 0;  // Safe to change end marker
+          if (dst->load_data_set_value(thd, pos, (uint) field->length,
+                                       &read_info))
+            DBUG_RETURN(1);
+        }
+      }
+
+      if (unlikely(thd->is_error()))
+      {
+        read_info.error= 1;
+        DBUG_RETURN(1);
+      }
+
+      while ((item= it++))
+      {
+        Load_data_outvar *dst= item->get_load_data_outvar_or_error();
+        DBUG_ASSERT(dst);
+        if (unlikely(dst->load_data_set_no_data(thd, &read_info)))
+          DBUG_RETURN(1);
+      }
+
+      if (unlikely(thd->killed) ||
+          unlikely(fill_record_n_invoke_before_triggers(thd, table, set_fields,
+                                                        set_values,
+                                                        ignore_check_option_errors,
+                                                        TRG_EVENT_INSERT)))
+        DBUG_RETURN(1);
+
+      switch (table_list->view_check_option(thd,
+                                            ignore_check_option_errors)) {
+      case VIEW_CHECK_SKIP:
+        continue;
+      case VIEW_CHECK_ERROR:
+        DBUG_RETURN(-1);
+      }
+
+      err= write_record(thd, table, &info);
+      table->auto_increment_field_not_null= FALSE;
+      if (err)
+        DBUG_RETURN(1);
+
+      if (row.cut)
+      {
+        thd->cuted_fields++;			/* To long row */
+        push_warning_printf(thd, Sql_condition::WARN_LEVEL_WARN,
+                            ER_WARN_TOO_MANY_RECORDS,
+                            ER_THD(thd, ER_WARN_TOO_MANY_RECORDS),
+                            thd->get_stmt_da()->current_row_for_warning());
+        if (thd->killed)
+          DBUG_RETURN(1);
+      }
+      thd->get_stmt_da()->inc_current_row_for_warning();
+    }
+  }
+  DBUG_RETURN(MY_TEST(read_info.error));
+}
+
+
 /****************************************************************************
 ** Read rows in xml format
 ****************************************************************************/
@@ -1324,19 +1948,9 @@ read_xml_field(THD *thd, COPY_INFO &info, TABLE_LIST *table_list,
 char
 READ_INFO::unescape(char chr)
 {
-  /* keep this switch synchornous with the ESCAPE_CHARS macro */
-  switch(chr) {
-  case 'n': return '\n';
-  case 't': return '\t';
-  case 'r': return '\r';
-  case 'b': return '\b';
-  case '0': return 0;				// Ascii null
-  case 'Z': return '\032';			// Win32 end of file
-  case 'N': found_null=1;
-
-    /* fall through */
-  default:  return chr;
-  }
+  if (chr == 'N')
+    found_null=1;
+  return unescape_char(chr);
 }
 
 
@@ -1786,6 +2400,84 @@ bool READ_INFO::find_start_of_fields()
 }
 
 
+/*
+  Check whether the input can be split into lines without reading it
+  sequentially, for Load_data_parser.
+
+  Every line terminator that is not escaped must end a line. This is not
+  the case if fields can be enclosed, if the terminators or the escape
+  character can be a part of a multi-byte character, or if terminators
+  can overlap each other.
+*/
+
+bool READ_INFO::can_split_lines() const
+{
+  if (enclosed_char != INT_MAX || m_line_start.length() ||
+      !m_line_term.length() || !m_field_term.length() ||
+      !my_charset_is_ascii_based(charset()) ||
+      charset()->escape_with_backslash_is_dangerous ||
+      (escape_char != INT_MAX && (escape_char < 0 || escape_char >= 0x80)))
+    return false;
+
+  for (uint i= 0; i < m_field_term.length(); i++)
+  {
+    const uchar chr= m_field_term.ptr()[i];
+    if (chr >= 0x80 || chr == escape_char)
+      return false;
+  }
+  for (uint i= 0; i < m_line_term.length(); i++)
+  {
+    const uchar chr= m_line_term.ptr()[i];
+    if (chr >= 0x80 || chr == escape_char ||
+        memchr(m_field_term.ptr(), chr, m_field_term.length()))
+      return false;
+  }
+  /* A suffix of the line terminator must not be a prefix of it */
+  for (uint i= 1; i < m_line_term.length(); i++)
+    if (!memcmp(m_line_term.ptr(), m_line_term.ptr() + i,
+                m_line_term.length() - i))
+      return false;
+  return true;
+}
+
+
+/*
+  Read the input without interpreting it, for Load_data_parser.
+
+  @return number of bytes that were copied to 'to'
+  @retval 0 at end of file, or on error if error was set
+*/
+
+size_t READ_INFO::read_block(uchar *to, size_t length)
+{
+  size_t n= 0;
+  while (stack_pos != stack && n < length)
+  {
+    int chr= *--stack_pos;
+    if (chr != my_b_EOF)
+      to[n++]= (uchar) chr;
+  }
+  if (n)
+    return n;
+  if (!(n= my_b_bytes_in_cache(&cache)) && !(n= my_b_fill(&cache)))
+  {
+    /* my_b_fill() returns 0 on a read error as well */
+    if (cache.error)
+    {
+      /* Errors of files were already reported by my_read() (MY_WME) */
+      if (cache.type == READ_NET && !current_thd->is_error())
+        my_error(ER_NET_READ_ERROR, MYF(0));
+      error= 1;
+    }
+    return 0;
+  }
+  set_if_smaller(n, length);
+  memcpy(to, cache.read_pos, n);
+  cache.read_pos+= n;
+  return n;
+}
+
+
 /*
   Clear taglist from tags with a specified level
 */
@@ -0,0 +1,66 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"
+#include "sql_priv.h"
+#include "mysqld.h"                             // key_thread_parallel_worker
+#include "sql_parallel.h"
+
+static tpool::thread_pool *parallel_pool;
+
+
+static void parallel_thread_init()
+{
+  my_thread_init();
+  PSI_CALL_set_thread(PSI_CALL_new_thread(key_thread_parallel_worker,
+                                          NULL, 0));
+}
+
+
+static void parallel_thread_end()
+{
+  PSI_CALL_delete_current_thread();
+  my_thread_end();
+}
+
+
+void parallel_tasks_init()
+{
+  DBUG_ASSERT(!parallel_pool);
+  const int max_threads= MY_MAX(my_getncpus(), 1);
+#ifdef _WIN32
+  parallel_pool= tpool::create_thread_pool_win(1, max_threads);
+#else
+  parallel_pool= tpool::create_thread_pool_generic(1, max_threads);
+#endif
+  parallel_pool->set_thread_callbacks(parallel_thread_init,
+                                      parallel_thread_end);
+}
+
+
+void parallel_tasks_end()
+{
+  delete parallel_pool;
+  parallel_pool= NULL;
+}
+
+
+void Parallel_tasks::submit(uint n)
+{
+  DBUG_ASSERT(parallel_pool);
+  while (n--)
+    parallel_pool->submit_task(&m_task);
+}
@@ -0,0 +1,57 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_PARALLEL_INCLUDED
+#define SQL_PARALLEL_INCLUDED
+
+#include <tpool.h>
+
+/*
+  Helper threads for the parts of a statement that run in parallel
+  (sort_parallel_threads, load_data_parallel_threads)
+
+  All statements share one pool that has at most as many threads as
+  there are CPUs. The threads are initialized with my_thread_init() and
+  are instrumented as thread/sql/parallel_worker.
+
+  A task may be queued behind the tasks of other statements for a while.
+  So it must not wait for the statement that submitted it, and that
+  statement must be able to do all the work itself.
+*/
+
+class Parallel_tasks
+{
+public:
+  /*
+    @param func  function to execute in the pool
+    @param arg   argument of func
+  */
+  Parallel_tasks(tpool::callback_func func, void *arg) : m_task(func, arg) {}
+  ~Parallel_tasks() { wait(); }
+
+  /* Execute func(arg) in n pool threads */
+  void submit(uint n);
+  /* Wait until all executions of func(arg) have completed */
+  void wait() { m_task.wait(); }
+
+private:
+  tpool::waitable_task m_task;
+};
+
+void parallel_tasks_init();
+void parallel_tasks_end();
+
+#endif /* SQL_PARALLEL_INCLUDED */
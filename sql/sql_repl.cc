@@ -30,6 +30,7 @@
 #include "debug_sync.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
+#include "rpl_dump_cache.h"
 #include "mysys_err.h"
 
 
@@ -2693,9 +2694,20 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
       return 1;
 
     info->last_pos= linfo->pos;
-    error= Log_event::read_log_event(log, packet, info->fdev,
-                       opt_master_verify_checksum ? info->current_checksum_alg
-                                                  : BINLOG_CHECKSUM_ALG_OFF);
+    const bool verify= opt_master_verify_checksum;
+    if (size_t len= binlog_dump_cache.read(info->log_file_name, linfo->pos,
+                                           end_pos, verify, packet))
+    {
+      /* Another dump thread read, decrypted and verified the event */
+      error= 0;
+      my_b_seek(log, linfo->pos + len);
+    }
+    else if (!(error= Log_event::read_log_event(log, packet, info->fdev,
+                          verify ? info->current_checksum_alg
+                                 : BINLOG_CHECKSUM_ALG_OFF)))
+      binlog_dump_cache.append(info->log_file_name, linfo->pos,
+                               (uchar*) packet->ptr() + ev_offset,
+                               packet->length() - ev_offset, verify);
     linfo->pos= my_b_tell(log);
 
     if (unlikely(error))
@@ -4096,6 +4108,8 @@ int reset_master(THD* thd, rpl_gtid *init_state, uint32 init_state_len,
   repl_semisync_master.before_reset_master();
   ret= mysql_bin_log.reset_logs(thd, 1, init_state, init_state_len,
                                 next_log_number);
+  /* The names of the deleted binary logs may be reused. */
+  binlog_dump_cache.clear();
   repl_semisync_master.after_reset_master();
   DBUG_EXECUTE_IF("crash_after_reset_master", DBUG_SUICIDE(););
 
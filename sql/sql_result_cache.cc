@@ -0,0 +1,573 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "mariadb.h"                          /* NO_EMBEDDED_ACCESS_CHECKS */
+#include "sql_priv.h"
+#ifdef HAVE_QUERY_CACHE
+
+#include "sql_class.h"
+#include "sql_cache.h"
+#include "sql_parse.h"                          // check_table_access
+#include "sql_base.h"                           // get_table_def_key
+#include "probes_mysql.h"
+#include "mysqld.h"
+#include "transaction.h"
+
+Result_cache result_cache;
+ulonglong result_cache_size;
+ulong result_cache_limit;
+
+
+/* A table that a cached result depends on */
+
+struct Result_cache_table
+{
+  /* table_cache_key: database name and table name, both 0-terminated */
+  const char *key;
+  uint key_length;
+  /* the version counter of the table when the statement started */
+  ulonglong version;
+  /* engine callback from handler::register_query_cache_table() */
+  qc_engine_callback callback;
+  ulonglong engine_data;
+};
+
+
+/*
+  A cached result. The tables, their keys and the result packets are
+  allocated in the same block as this.
+*/
+
+struct Result_cache_entry
+{
+  uchar digest[MD5_HASH_SIZE];
+  /* LRU list of the shard */
+  Result_cache_entry *prev, *next;
+  /* allocated bytes */
+  size_t size;
+  /* number of threads that are sending the result */
+  uint refs;
+  /* whether the entry was removed from the shard */
+  bool removed;
+  uint8 tables_type;
+  uint n_tables;
+  Result_cache_table *tables;
+  ulonglong epoch;
+  ulonglong found_rows;
+  uint last_pkt_nr;
+  uchar *data;
+  size_t length;
+};
+
+
+/* The result that is being collected by a thread */
+
+struct Result_cache_writer
+{
+  uchar digest[MD5_HASH_SIZE];
+  uint8 tables_type;
+  uint n_tables;
+  Result_cache_table *tables;
+  /* total length of the table keys */
+  size_t keys_length;
+  ulonglong epoch;
+  uint last_pkt_nr;
+  uchar *data;
+  size_t length, alloced;
+};
+
+
+void Result_cache::init()
+{
+  for (Shard *s= m_shards; s < m_shards + RESULT_CACHE_SHARDS; s++)
+  {
+    mysql_mutex_init(key_LOCK_result_cache, &s->lock, MY_MUTEX_INIT_FAST);
+    my_hash_init(key_memory_Query_cache, &s->entries, &my_charset_bin, 64,
+                 offsetof(Result_cache_entry, digest), MD5_HASH_SIZE, 0, 0,
+                 0);
+    s->lru_first= s->lru_last= NULL;
+    s->used= 0;
+  }
+  for (size_t i= 0; i < RESULT_CACHE_TABLE_VERSIONS; i++)
+    m_versions[i].store(0, std::memory_order_relaxed);
+  m_epoch.store(0, std::memory_order_relaxed);
+  m_size.store(0, std::memory_order_relaxed);
+}
+
+
+void Result_cache::destroy()
+{
+  if (!my_hash_inited(&m_shards[0].entries))
+    return;                                     // init() was not called
+  m_size.store(0, std::memory_order_relaxed);
+  flush();
+  for (Shard *s= m_shards; s < m_shards + RESULT_CACHE_SHARDS; s++)
+  {
+    my_hash_free(&s->entries);
+    mysql_mutex_destroy(&s->lock);
+  }
+}
+
+
+void Result_cache::resize(size_t size)
+{
+  m_size.store(size, std::memory_order_relaxed);
+  flush();
+}
+
+
+std::atomic<ulonglong> &Result_cache::version(const uchar *key,
+                                              size_t key_length)
+{
+  return m_versions[my_crc32c(0, key, key_length) &
+                    (RESULT_CACHE_TABLE_VERSIONS - 1)];
+}
+
+
+void Result_cache::invalidate_table(const uchar *key, size_t key_length)
+{
+  version(key, key_length).fetch_add(1);
+}
+
+
+bool Result_cache::is_stale(const Result_cache_entry *entry)
+{
+  if (entry->epoch != m_epoch.load(std::memory_order_acquire))
+    return true;
+  for (uint i= 0; i < entry->n_tables; i++)
+  {
+    const Result_cache_table *t= entry->tables + i;
+    if (t->version != version((const uchar*) t->key, t->key_length).
+                      load(std::memory_order_acquire))
+      return true;
+  }
+  return false;
+}
+
+
+/* Remove an entry from its shard. The caller holds shard->lock. */
+
+void Result_cache::remove(Shard *shard, Result_cache_entry *entry)
+{
+  mysql_mutex_assert_owner(&shard->lock);
+  my_hash_delete(&shard->entries, (uchar*) entry);
+  if (entry->prev)
+    entry->prev->next= entry->next;
+  else
+    shard->lru_first= entry->next;
+  if (entry->next)
+    entry->next->prev= entry->prev;
+  else
+    shard->lru_last= entry->prev;
+  shard->used-= entry->size;
+  entry->removed= true;
+  if (!entry->refs)
+    my_free(entry);
+}
+
+
+/* Unpin an entry that was found by send_result_to_client() */
+
+void Result_cache::release(Result_cache_entry *entry)
+{
+  Shard *s= shard(entry->digest);
+  mysql_mutex_lock(&s->lock);
+  DBUG_ASSERT(entry->refs);
+  if (!--entry->refs && entry->removed)
+    my_free(entry);
+  mysql_mutex_unlock(&s->lock);
+}
+
+
+void Result_cache::flush()
+{
+  for (Shard *s= m_shards; s < m_shards + RESULT_CACHE_SHARDS; s++)
+  {
+    mysql_mutex_lock(&s->lock);
+    while (s->lru_first)
+      remove(s, s->lru_first);
+    mysql_mutex_unlock(&s->lock);
+  }
+}
+
+
+int Result_cache::send_result_to_client(THD *thd, const char *key,
+                                        size_t length)
+{
+  Query_cache_tls *tls= &thd->query_cache_tls;
+  Result_cache_entry *entry;
+  DBUG_ENTER("Result_cache::send_result_to_client");
+
+  my_md5(tls->result_cache_digest, key, length);
+  tls->result_cache_lookup= true;
+
+  Shard *s= shard(tls->result_cache_digest);
+  mysql_mutex_lock(&s->lock);
+  entry= (Result_cache_entry*) my_hash_search(&s->entries,
+                                              tls->result_cache_digest,
+                                              MD5_HASH_SIZE);
+  if (entry && is_stale(entry))
+  {
+    DBUG_PRINT("qcache", ("Cached result is stale"));
+    remove(s, entry);
+    entry= NULL;
+  }
+  if (!entry)
+  {
+    mysql_mutex_unlock(&s->lock);
+    MYSQL_QUERY_CACHE_MISS(thd->query());
+    DBUG_RETURN(0);
+  }
+  entry->refs++;
+  if (entry->prev)
+  {
+    /* Move the entry to the front of the LRU list */
+    entry->prev->next= entry->next;
+    if (entry->next)
+      entry->next->prev= entry->prev;
+    else
+      s->lru_last= entry->prev;
+    entry->prev= NULL;
+    entry->next= s->lru_first;
+    s->lru_first->prev= entry;
+    s->lru_first= entry;
+  }
+  mysql_mutex_unlock(&s->lock);
+
+  if (thd->in_multi_stmt_transaction_mode() &&
+      (entry->tables_type & HA_CACHE_TBL_TRANSACT))
+  {
+    DBUG_PRINT("qcache",
+               ("we are in transaction and have transaction tables in query"));
+    release(entry);
+    DBUG_RETURN(0);
+  }
+
+  THD_STAGE_INFO(thd, stage_checking_privileges_on_cached_query);
+  for (uint i= 0; i < entry->n_tables; i++)
+  {
+    const Result_cache_table *table= entry->tables + i;
+    TABLE_LIST table_list;
+    size_t db_length= strlen(table->key);
+
+    /* A temporary table hides the table that the result was read from */
+    if (thd->find_tmp_table_share_w_base_key(table->key, table->key_length))
+    {
+      DBUG_PRINT("qcache", ("Temporary table detected: '%s'", table->key));
+      release(entry);
+      thd->query_cache_is_applicable= 0;        // Query can't be cached
+      thd->lex->safe_to_cache_query= 0;         // For prepared statements
+      DBUG_RETURN(-1);
+    }
+
+    bzero((char*) &table_list, sizeof(table_list));
+    table_list.db.str= table->key;
+    table_list.db.length= db_length;
+    table_list.alias.str= table_list.table_name.str= table->key + db_length + 1;
+    table_list.alias.length= table_list.table_name.length=
+      strlen(table_list.table_name.str);
+
+#ifndef NO_EMBEDDED_ACCESS_CHECKS
+    if (check_table_access(thd, SELECT_ACL, &table_list, FALSE, 1, TRUE))
+    {
+      release(entry);
+      thd->query_cache_is_applicable= 0;        // Query can't be cached
+      thd->lex->safe_to_cache_query= 0;         // For prepared statements
+      DBUG_RETURN(-1);                          // Privilege error
+    }
+    if (table_list.grant.want_privilege)
+    {
+      release(entry);
+      thd->query_cache_is_applicable= 0;        // Query can't be cached
+      thd->lex->safe_to_cache_query= 0;         // For prepared statements
+      DBUG_RETURN(0);                           // Parse query
+    }
+#endif /*!NO_EMBEDDED_ACCESS_CHECKS*/
+
+    if (table->callback)
+    {
+      char qcache_se_key_name[FN_REFLEN + 10];
+      ulonglong engine_data= table->engine_data;
+      size_t qcache_se_key_len=
+        build_normalized_name(qcache_se_key_name, sizeof(qcache_se_key_name),
+                              table_list.db.str, table_list.db.length,
+                              table_list.table_name.str,
+                              table_list.table_name.length, 0);
+      if (!(*table->callback)(thd, qcache_se_key_name,
+                              (uint) qcache_se_key_len, &engine_data))
+      {
+        DBUG_PRINT("qcache", ("Handler does not allow caching for %.*s",
+                              (int) qcache_se_key_len, qcache_se_key_name));
+        if (engine_data != table->engine_data)
+          invalidate_table((const uchar*) table->key, table->key_length);
+        else
+          thd->query_cache_is_applicable= 0;    // Query can't be cached
+        /* See Query_cache::send_result_to_client() */
+        DBUG_ASSERT(!thd->transaction_rollback_request);
+        trans_rollback_stmt(thd);
+        release(entry);
+        DBUG_RETURN(0);
+      }
+    }
+  }
+
+#ifndef EMBEDDED_LIBRARY
+  THD_STAGE_INFO(thd, stage_sending_cached_result_to_client);
+  send_data_in_chunks(&thd->net, entry->data, entry->length);
+  thd->net.pkt_nr= entry->last_pkt_nr;
+#else
+  DBUG_ASSERT(0);
+#endif
+
+  thd->set_sent_row_count(thd->limit_found_rows= entry->found_rows);
+  thd->status_var.last_query_cost= 0.0;
+  thd->query_plan_flags= (thd->query_plan_flags & ~QPLAN_QC_NO) | QPLAN_QC;
+  if (!thd->get_sent_row_count())
+    status_var_increment(thd->status_var.empty_queries);
+  else
+    status_var_add(thd->status_var.rows_sent, thd->get_sent_row_count());
+
+  /* End the statement transaction potentially started by a callback */
+  (void) trans_commit_stmt(thd);
+  thd->get_stmt_da()->disable_status();
+
+  release(entry);
+  hits++;
+  MYSQL_QUERY_CACHE_HIT(thd->query(), thd->limit_found_rows);
+  DBUG_RETURN(1);
+}
+
+
+void Result_cache::store_query(THD *thd, TABLE_LIST *tables_used,
+                               uint8 tables_type)
+{
+  Query_cache_tls *tls= &thd->query_cache_tls;
+  Result_cache_writer *writer;
+  TABLE_LIST *tl;
+  uint n_tables= 0;
+  size_t keys_length= 0;
+  DBUG_ENTER("Result_cache::store_query");
+  DBUG_ASSERT(tls->result_cache_lookup);
+
+  if (!is_enabled() || tls->result_writer)
+    DBUG_VOID_RETURN;
+
+  for (tl= tables_used; tl; tl= tl->next_global)
+  {
+    const char *key;
+    if (tl->is_anonymous_derived_table() || tl->table_function)
+      continue;
+    if (!tl->view)
+    {
+      /*
+        The partitions of a partitioned table are checked by the engine
+        callbacks of the partitions, which only the query cache can
+        register.
+      */
+      uint8 dummy= 0;
+      if (tl->table->file->count_query_cache_dependant_tables(&dummy))
+      {
+        DBUG_PRINT("qcache", ("Table %s has dependant tables",
+                              tl->table->s->table_name.str));
+        DBUG_VOID_RETURN;
+      }
+      keys_length+= tl->table->s->table_cache_key.length;
+    }
+    else
+      keys_length+= get_table_def_key(tl, &key);
+    n_tables++;
+  }
+  if (!n_tables || Query_cache::ask_handler_allowance(thd, tables_used))
+    DBUG_VOID_RETURN;
+
+  if (!(writer= (Result_cache_writer*)
+        my_malloc(key_memory_Query_cache,
+                  sizeof(*writer) + n_tables * sizeof(Result_cache_table) +
+                  keys_length, MYF(0))))
+    DBUG_VOID_RETURN;
+
+  memcpy(writer->digest, tls->result_cache_digest, MD5_HASH_SIZE);
+  writer->tables_type= tables_type;
+  writer->n_tables= n_tables;
+  writer->tables= (Result_cache_table*) (writer + 1);
+  writer->keys_length= keys_length;
+  writer->epoch= m_epoch.load(std::memory_order_acquire);
+  writer->last_pkt_nr= 0;
+  writer->data= NULL;
+  writer->length= writer->alloced= 0;
+
+  char *keys= (char*) (writer->tables + n_tables);
+  Result_cache_table *t= writer->tables;
+  for (tl= tables_used; tl; tl= tl->next_global)
+  {
+    const char *key;
+    if (tl->is_anonymous_derived_table() || tl->table_function)
+      continue;
+    if (tl->view)
+    {
+      /* There are no callback functions for VIEWs */
+      t->key_length= get_table_def_key(tl, &key);
+      t->callback= 0;
+      t->engine_data= 0;
+    }
+    else
+    {
+      key= tl->table->s->table_cache_key.str;
+      t->key_length= (uint) tl->table->s->table_cache_key.length;
+      t->callback= tl->callback_func;
+      t->engine_data= tl->engine_data;
+    }
+    memcpy(keys, key, t->key_length);
+    t->key= keys;
+    keys+= t->key_length;
+    t->version= version((const uchar*) key, t->key_length).
+                load(std::memory_order_acquire);
+    t++;
+  }
+
+  tls->result_writer= writer;
+  DBUG_VOID_RETURN;
+}
+
+
+void Result_cache::free_writer(Query_cache_tls *tls)
+{
+  my_free(tls->result_writer->data);
+  my_free(tls->result_writer);
+  tls->result_writer= NULL;
+}
+
+
+void Result_cache::insert(Query_cache_tls *tls, const char *packet,
+                          size_t length, uint pkt_nr)
+{
+  Result_cache_writer *writer= tls->result_writer;
+  DBUG_ASSERT(writer);
+
+  if (writer->length + length > writer->alloced)
+  {
+    size_t alloced= MY_MAX(writer->alloced * 2, writer->length + length);
+    uchar *data;
+    if (writer->length + length > result_cache_limit ||
+        !(data= (uchar*) my_realloc(key_memory_Query_cache, writer->data,
+                                    alloced, MYF(MY_ALLOW_ZERO_PTR))))
+    {
+      DBUG_PRINT("qcache", ("Result is too big"));
+      free_writer(tls);
+      return;
+    }
+    writer->data= data;
+    writer->alloced= alloced;
+  }
+  memcpy(writer->data + writer->length, packet, length);
+  writer->length+= length;
+  writer->last_pkt_nr= pkt_nr;
+}
+
+
+void Result_cache::abort(Query_cache_tls *tls)
+{
+  if (tls->result_writer)
+    free_writer(tls);
+}
+
+
+void Result_cache::end_of_result(THD *thd)
+{
+  Query_cache_tls *tls= &thd->query_cache_tls;
+  Result_cache_writer *writer= tls->result_writer;
+  Result_cache_entry *entry;
+  DBUG_ENTER("Result_cache::end_of_result");
+
+  if (!writer)
+    DBUG_VOID_RETURN;
+
+  /* Ensure that only complete results are cached. */
+  DBUG_ASSERT(thd->get_stmt_da()->is_eof());
+
+  const size_t size= sizeof(*entry) +
+    writer->n_tables * sizeof(Result_cache_table) +
+    writer->keys_length + writer->length;
+  const size_t shard_size= m_size.load(std::memory_order_relaxed) /
+    RESULT_CACHE_SHARDS;
+  if (thd->killed || !writer->length || size > shard_size)
+    goto end;
+
+  if (!(entry= (Result_cache_entry*) my_malloc(key_memory_Query_cache, size,
+                                               MYF(0))))
+    goto end;
+
+  memcpy(entry->digest, writer->digest, MD5_HASH_SIZE);
+  entry->prev= entry->next= NULL;
+  entry->size= size;
+  entry->refs= 0;
+  entry->removed= false;
+  entry->tables_type= writer->tables_type;
+  entry->n_tables= writer->n_tables;
+  entry->tables= (Result_cache_table*) (entry + 1);
+  entry->epoch= writer->epoch;
+  entry->found_rows= thd->limit_found_rows;
+  entry->last_pkt_nr= writer->last_pkt_nr;
+  entry->data= ((uchar*) (entry->tables + entry->n_tables) +
+                writer->keys_length);
+  entry->length= writer->length;
+  memcpy(entry->tables, writer->tables,
+         writer->n_tables * sizeof(Result_cache_table) + writer->keys_length);
+  for (uint i= 0; i < entry->n_tables; i++)
+    entry->tables[i].key= ((const char*) entry->tables +
+                           (writer->tables[i].key -
+                            (const char*) writer->tables));
+  memcpy(entry->data, writer->data, writer->length);
+
+  {
+    Shard *s= shard(entry->digest);
+    Result_cache_entry *old;
+    mysql_mutex_lock(&s->lock);
+    /* A table was changed while the statement was running */
+    if (is_stale(entry))
+    {
+      mysql_mutex_unlock(&s->lock);
+      my_free(entry);
+      goto end;
+    }
+    if ((old= (Result_cache_entry*) my_hash_search(&s->entries, entry->digest,
+                                                   MD5_HASH_SIZE)))
+      remove(s, old);
+    while (s->lru_last && s->used + size > shard_size)
+      remove(s, s->lru_last);
+    if (my_hash_insert(&s->entries, (uchar*) entry))
+    {
+      mysql_mutex_unlock(&s->lock);
+      my_free(entry);
+      goto end;
+    }
+    entry->next= s->lru_first;
+    if (s->lru_first)
+      s->lru_first->prev= entry;
+    else
+      s->lru_last= entry;
+    s->lru_first= entry;
+    s->used+= size;
+    mysql_mutex_unlock(&s->lock);
+    inserts++;
+  }
+
+end:
+  free_writer(tls);
+  DBUG_VOID_RETURN;
+}
+
+#endif /* HAVE_QUERY_CACHE */
@@ -0,0 +1,155 @@
+/*
+   Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_RESULT_CACHE_INCLUDED
+#define SQL_RESULT_CACHE_INCLUDED
+
+#include "mariadb.h"
+#include "my_sys.h"
+#include "hash.h"
+#include "my_md5.h"
+#include "my_counter.h"
+#include "mysql/psi/mysql_thread.h"
+#include <atomic>
+
+class THD;
+struct TABLE_LIST;
+struct Query_cache_tls;
+struct Result_cache_entry;
+struct Result_cache_writer;
+
+/* Number of independently locked partitions of the result cache */
+#define RESULT_CACHE_SHARDS 32
+/* Number of table version counters; must be a power of 2 */
+#define RESULT_CACHE_TABLE_VERSIONS 4096
+
+/*
+  Cache of SELECT results that does not serialize the server
+  (result_cache_size)
+
+  The query cache has one mutex that every cached SELECT and every
+  table change must take, so it has to stay disabled on busy servers.
+  The result cache is used instead of it when query_cache_type=OFF or
+  query_cache_size=0. It takes over the hooks of the query cache, so a
+  statement is looked up, stored and invalidated at the same places.
+
+  - The statement is identified by the MD5 digest of its text without
+    comments and repeated white space, the current database and the
+    session settings that affect the result (Query_cache_query_flags).
+    Prepared statements are looked up with the parameter values
+    substituted, as in the query cache.
+
+  - The entries are spread over RESULT_CACHE_SHARDS partitions by
+    their digest. Each partition has its own mutex, hash, LRU list and
+    a share of result_cache_size. The mutex is only held to find,
+    insert or remove an entry; the result is sent with the entry
+    pinned and no mutex held.
+
+  - A table change only increments the version counter of the table.
+    An entry remembers the versions of its tables from the start of the
+    statement that stored it. It is stale as soon as one of them
+    differs, and is removed when it is found or evicted. The counters
+    are indexed by a hash of the table key, so a change of one table
+    can also make the entries of another table stale.
+*/
+
+class Result_cache
+{
+public:
+  void init();
+  void destroy();
+
+#ifdef EMBEDDED_LIBRARY
+  bool is_enabled() const { return false; }
+#else
+  bool is_enabled() const
+  { return m_size.load(std::memory_order_relaxed) != 0; }
+#endif
+
+  /* Change the size. All cached results are discarded. */
+  void resize(size_t size);
+
+  /*
+    Look up a statement and send its result to the client.
+
+    @param thd     thread handle
+    @param key     the query cache key: statement text, database and
+                   Query_cache_query_flags
+    @param length  length of key
+
+    @return as for Query_cache::send_result_to_client()
+  */
+  int send_result_to_client(THD *thd, const char *key, size_t length);
+
+  /*
+    Start to store the result of the statement that was looked up
+    last. tables_type is from Query_cache::is_cacheable().
+  */
+  void store_query(THD *thd, TABLE_LIST *tables_used, uint8 tables_type);
+
+  /* Append a network packet of the result */
+  void insert(Query_cache_tls *tls, const char *packet, size_t length,
+              uint pkt_nr);
+  /* Cache the result unless one of its tables was changed */
+  void end_of_result(THD *thd);
+  /* Do not cache the result */
+  void abort(Query_cache_tls *tls);
+
+  /* Make the results that use a table stale */
+  void invalidate_table(const uchar *key, size_t key_length);
+  /* Make all cached results stale */
+  void invalidate_all() { m_epoch.fetch_add(1); }
+  /* Free all cached results */
+  void flush();
+
+  /* Number of statements that were answered from the cache */
+  Atomic_counter<ulonglong> hits;
+  /* Number of results that were added to the cache */
+  Atomic_counter<ulonglong> inserts;
+
+private:
+  struct Shard
+  {
+    mysql_mutex_t lock;
+    /* Result_cache_entry by digest */
+    HASH entries;
+    /* most recently used entry; the oldest is lru_last */
+    Result_cache_entry *lru_first, *lru_last;
+    /* bytes allocated for the entries */
+    size_t used;
+  };
+
+  Shard *shard(const uchar *digest)
+  { return &m_shards[digest[0] % RESULT_CACHE_SHARDS]; }
+  std::atomic<ulonglong> &version(const uchar *key, size_t key_length);
+  bool is_stale(const Result_cache_entry *entry);
+  void remove(Shard *shard, Result_cache_entry *entry);
+  void release(Result_cache_entry *entry);
+  void free_writer(Query_cache_tls *tls);
+
+  Shard m_shards[RESULT_CACHE_SHARDS];
+  std::atomic<ulonglong> m_versions[RESULT_CACHE_TABLE_VERSIONS];
+  /* incremented to make all entries stale */
+  std::atomic<ulonglong> m_epoch;
+  /* result_cache_size, or 0 if the cache is disabled */
+  std::atomic<size_t> m_size;
+};
+
+extern Result_cache result_cache;
+extern ulonglong result_cache_size;
+extern ulong result_cache_limit;
+
+#endif /* SQL_RESULT_CACHE_INCLUDED */
@@ -64,6 +64,7 @@
 #include "sp_head.h"
 #include "sp_rcontext.h"
 #include "rowid_filter.h"
+#include "cond_filter.h"
 #include "select_handler.h"
 #include "my_json_writer.h"
 #include "opt_trace.h"
@@ -4450,6 +4451,9 @@ JOIN::reinit()
          tab= next_linear_tab(this, tab, WITH_BUSH_ROOTS))
     {
       tab->ref.key_err= TRUE;
+      /* A previous execution may have left the join unfinished */
+      if (tab->cache)
+        tab->cache->reset_spill();
     }
   }
 
@@ -19832,9 +19836,22 @@ bool Create_tmp_table::choose_engine(THD *thd, TABLE *table,
   /*
     If result table is small; use a heap, otherwise TMP_TABLE_HTON (Aria)
     In the future we should try making storage engine selection more dynamic
+
+    A heap table can store blobs (tmp_memory_table_blobs) but cannot
+    have them in a key, so a DISTINCT or GROUP BY over blobs still needs
+    Aria. This includes short blobs like TINYTEXT, for which no unique
+    constraint is used.
   */
+  bool blob_in_key= m_distinct && m_blobs_count[distinct];
+  for (ORDER *tmp= m_group; tmp && !blob_in_key; tmp= tmp->next)
+  {
+    Field *field= (*tmp->item)->get_tmp_table_field();
+    blob_in_key= field && (field->flags & BLOB_FLAG);
+  }
 
-  if (share->blob_fields || m_using_unique_constraint ||
+  if ((share->blob_fields &&
+       (!thd->variables.tmp_memory_table_blobs || blob_in_key)) ||
+      m_using_unique_constraint ||
       (thd->variables.big_tables &&
        !(m_select_options & SELECT_SMALL_RESULT)) ||
       (m_select_options & TMP_TABLE_FORCE_MYISAM) ||
@@ -21614,6 +21631,7 @@ sub_select_cache(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
   if (end_of_records)
   {
     rc= cache->join_records(FALSE);
+    rc= cache->join_spilled_records(rc);
     if (rc == NESTED_LOOP_OK || rc == NESTED_LOOP_NO_MORE_ROWS ||
         rc == NESTED_LOOP_QUERY_LIMIT)
       rc= sub_select(join, join_tab, end_of_records);
@@ -21624,6 +21642,8 @@ sub_select_cache(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
     /* The user has aborted the execution of the query */
     DBUG_RETURN(NESTED_LOOP_KILLED);
   }
+  if (cache->is_spilled())
+    DBUG_RETURN(cache->spill_record() ? NESTED_LOOP_ERROR : NESTED_LOOP_OK);
   if (!test_if_use_dynamic_range_scan(join_tab))
   {
     if (!cache->put_record())
@@ -21939,7 +21959,16 @@ evaluate_join_record(JOIN *join, JOIN_TAB *join_tab,
 
   if (select_cond)
   {
-    select_cond_result= MY_TEST(select_cond->val_int());
+    if (unlikely(join_tab->select_cond_filter_for != select_cond))
+    {
+      join_tab->select_cond_filter= Cond_filter::create(join->thd,
+                                                        select_cond);
+      join_tab->select_cond_filter_for= select_cond;
+    }
+
+    select_cond_result= join_tab->select_cond_filter
+      ? join_tab->select_cond_filter->eval()
+      : MY_TEST(select_cond->val_int());
 
     /* check for errors evaluating the condition */
     if (unlikely(join->thd->is_error()))
@@ -25310,8 +25339,8 @@ JOIN_TAB::remove_duplicates()
     thd->reset_killed();
 
   table->file->info(HA_STATUS_VARIABLE);
-  if (table->s->db_type() == heap_hton ||
-      (!table->s->blob_fields &&
+  if (!table->s->blob_fields &&
+      (table->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(keylength) + HASH_OVERHEAD) * table->file->stats.records <
 	thd->variables.sortbuff_size)))
     error=remove_dup_with_hash_index(join->thd, table, field_count, first_field,
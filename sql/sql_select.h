@@ -249,6 +249,7 @@ class AGGR_OP;
 class Filesort;
 struct SplM_plan_info;
 class SplM_opt_info;
+class Cond_filter;
 
 typedef struct st_join_table {
   TABLE		*table;
@@ -258,6 +259,12 @@ typedef struct st_join_table {
                                     not supported by any index               */
   SQL_SELECT	*select;
   COND		*select_cond;
+  /*
+    Compiled form of select_cond (see cond_filter.h), or NULL.
+    It is valid while select_cond_filter_for == select_cond.
+  */
+  Cond_filter   *select_cond_filter;
+  COND          *select_cond_filter_for;
   COND          *on_precond;    /**< part of on condition to check before
                                      accessing the first inner table         */
   QUICK_SELECT_I *quick;
@@ -561,6 +561,7 @@ class Sort_param {
   ha_rows *accepted_rows;         /* For ROWNUM */
   bool using_pq;
   bool set_all_read_bits;
+  uint sort_threads;              // Max threads for sorting the buffer
 
   uchar *unique_buff;
   bool not_killable;
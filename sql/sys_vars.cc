@@ -64,6 +64,7 @@
 #include "rpl_parallel.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
+#include "rpl_dump_cache.h"
 #include <ssl_compat.h>
 #ifdef WITH_WSREP
 #include "wsrep_mysqld.h"
@@ -1443,6 +1444,13 @@ static Sys_var_mybool Sys_local_infile(
        "local_infile", "Enable LOAD DATA LOCAL INFILE",
        GLOBAL_VAR(opt_local_infile), CMD_LINE(OPT_ARG), DEFAULT(TRUE));
 
+static Sys_var_uint Sys_load_data_parallel_threads(
+       "load_data_parallel_threads",
+       "Maximum number of threads that split the lines of LOAD DATA input "
+       "into fields. 1 disables parallel parsing",
+       SESSION_VAR(load_data_parallel_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_lock_wait_timeout(
        "lock_wait_timeout",
        "Timeout in seconds to wait for a lock before returning an error.",
@@ -3315,6 +3323,29 @@ static Sys_var_mybool Sys_query_cache_wlock_invalidate(
        "Invalidate queries in query cache on LOCK for write",
        SESSION_VAR(query_cache_wlock_invalidate), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
+
+static bool fix_result_cache_size(sys_var *self, THD *thd, enum_var_type type)
+{
+  result_cache.resize((size_t) result_cache_size);
+  return false;
+}
+static Sys_var_ulonglong Sys_result_cache_size(
+       "result_cache_size",
+       "The memory allocated to store results of SELECT statements when "
+       "the query cache is not used (query_cache_type=OFF or "
+       "query_cache_size=0). Unlike the query cache, the result cache has "
+       "no global mutex and invalidates results with per-table version "
+       "counters. 0 disables it",
+       GLOBAL_VAR(result_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(1024),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_result_cache_size));
+
+static Sys_var_ulong Sys_result_cache_limit(
+       "result_cache_limit",
+       "Don't store results that are bigger than this in the result cache",
+       GLOBAL_VAR(result_cache_limit), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(1024*1024), BLOCK_SIZE(1));
 #endif /* HAVE_QUERY_CACHE */
 
 static Sys_var_on_access_global<Sys_var_mybool,
@@ -3494,6 +3525,23 @@ Sys_master_verify_checksum(
        GLOBAL_VAR(opt_master_verify_checksum), CMD_LINE(OPT_ARG),
        DEFAULT(FALSE));
 
+static bool fix_binlog_dump_cache_size(sys_var *, THD *, enum_var_type)
+{
+  binlog_dump_cache.clear();
+  return false;
+}
+
+static Sys_var_ulonglong Sys_binlog_dump_cache_size(
+       "binlog_dump_cache_size",
+       "Size of the memory buffer of recently sent binary log events that "
+       "is shared by all binlog dump threads. An event is read, decrypted "
+       "and checksum-verified only once for all slaves that are close to "
+       "the end of the binary log. 0 disables the buffer",
+       GLOBAL_VAR(opt_binlog_dump_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, SIZE_T_MAX), DEFAULT(0), BLOCK_SIZE(IO_SIZE),
+       NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0),
+       ON_UPDATE(fix_binlog_dump_cache_size));
+
 /* These names must match RPL_SKIP_XXX #defines in slave.h. */
 static const char *replicate_events_marked_for_skip_names[]= {
   "REPLICATE", "FILTER_ON_SLAVE", "FILTER_ON_MASTER", 0
@@ -3729,6 +3777,13 @@ static Sys_var_ulonglong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, SIZE_T_MAX), DEFAULT(MAX_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_uint Sys_sort_parallel_threads(
+       "sort_parallel_threads",
+       "Maximum number of threads that sort the keys in the sort buffer. "
+       "1 disables parallel sorting",
+       SESSION_VAR(sort_parallel_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 export sql_mode_t expand_sql_mode(sql_mode_t sql_mode)
 {
   if (sql_mode & MODE_ANSI)
@@ -4267,6 +4322,14 @@ static Sys_var_ulonglong Sys_tmp_memory_table_size(
        VALID_RANGE(0, (ulonglong)~(intptr)0), DEFAULT(16*1024*1024),
        BLOCK_SIZE(1));
 
+static Sys_var_mybool Sys_tmp_memory_table_blobs(
+       "tmp_memory_table_blobs",
+       "Use in-memory (MEMORY) internal temporary tables also when they have "
+       "BLOB or TEXT columns, unless a unique key over the BLOB columns is "
+       "needed",
+       SESSION_VAR(tmp_memory_table_blobs), CMD_LINE(OPT_ARG),
+       DEFAULT(FALSE));
+
 static Sys_var_ulonglong Sys_tmp_disk_table_size(
        "tmp_disk_table_size",
        "Max size for data for an internal temporary on-disk MyISAM or Aria table.",
@@ -6633,6 +6696,15 @@ static Sys_var_ulonglong Sys_join_buffer_space_limit(
        VALID_RANGE(2048, ULONGLONG_MAX), DEFAULT(16*128*1024),
        BLOCK_SIZE(2048));
 
+static Sys_var_ulong Sys_join_buffer_spill_threshold(
+       "join_buffer_spill_threshold",
+       "If the join buffer of a hashed block nested loop join is expected "
+       "to be refilled at least this many times, both join operands are "
+       "partitioned into temporary files by the join key, so that the "
+       "joined table is read only once. 0 disables the partitioning",
+       SESSION_VAR(join_buff_spill_threshold), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, UINT_MAX), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_progress_report_time(
        "progress_report_time",
        "Seconds between sending progress reports to the client for "
@@ -152,7 +152,9 @@ struct Table_cache_instance
   static void operator delete[](void *ptr) { aligned_free(ptr); }
 
   /**
-    Lock table cache mutex and check contention.
+    Check contention of the table cache mutex after acquiring it.
+
+    @param waited  whether mysql_mutex_trylock() failed
 
     Instance is considered contested if more than 20% of mutex acquisiotions
     can't be served immediately. Up to 100 000 probes may be performed to avoid
@@ -167,11 +169,11 @@ struct Table_cache_instance
     overhead on TABLE object release. All other table cache mutex acquistions
     are considered out of hot path and are not instrumented either.
   */
-  void lock_and_check_contention(uint32_t n_instances, uint32_t instance)
+  void check_contention(bool waited, uint32_t n_instances, uint32_t instance)
   {
-    if (mysql_mutex_trylock(&LOCK_table_cache))
+    mysql_mutex_assert_owner(&LOCK_table_cache);
+    if (waited)
     {
-      mysql_mutex_lock(&LOCK_table_cache);
       if (++mutex_waits == 20000)
       {
         if (n_instances < tc_instances)
@@ -379,22 +381,18 @@ void tc_add_table(THD *thd, TABLE *table)
 
 
 /**
-  Acquire TABLE object from table cache.
+  Take an unused TABLE object of a share from a table cache instance.
 
-  @pre share must be protected against removal.
-
-  Acquired object cannot be evicted or acquired again.
+  @pre LOCK_table_cache of the instance is locked. It is unlocked on return.
 
-  @return TABLE object, or NULL if no unused objects.
+  @return TABLE object, or NULL if no unused objects in the instance.
 */
 
-TABLE *tc_acquire_table(THD *thd, TDC_element *element)
+static TABLE *tc_pop_free_table(THD *thd, TDC_element *element, uint32_t i)
 {
-  uint32_t n_instances= tc_active_instances.load(std::memory_order_relaxed);
-  uint32_t i= thd->thread_id % n_instances;
   TABLE *table;
 
-  tc[i].lock_and_check_contention(n_instances, i);
+  mysql_mutex_assert_owner(&tc[i].LOCK_table_cache);
   table= element->free_tables[i].list.pop_front();
   if (table)
   {
@@ -411,6 +409,48 @@ TABLE *tc_acquire_table(THD *thd, TDC_element *element)
 }
 
 
+/**
+  Acquire TABLE object from table cache.
+
+  @pre share must be protected against removal.
+
+  Acquired object cannot be evicted or acquired again.
+
+  If the instance of this thread is locked by another thread, an
+  unused object of the share is taken from any other active instance
+  that can be locked without waiting. Only if there is none, we wait
+  for the instance of this thread, and count the wait towards the
+  activation of another instance. The object is released to the
+  instance it was taken from.
+
+  @return TABLE object, or NULL if no unused objects.
+*/
+
+TABLE *tc_acquire_table(THD *thd, TDC_element *element)
+{
+  uint32_t n_instances= tc_active_instances.load(std::memory_order_relaxed);
+  uint32_t i= thd->thread_id % n_instances;
+  bool waited= mysql_mutex_trylock(&tc[i].LOCK_table_cache);
+
+  if (waited)
+  {
+    for (uint32_t j= i + 1; j != i + n_instances; j++)
+    {
+      uint32_t k= j % n_instances;
+      /* Peek without the mutex; a wrong guess is harmless. */
+      if (element->free_tables[k].list.is_empty() ||
+          mysql_mutex_trylock(&tc[k].LOCK_table_cache))
+        continue;
+      if (TABLE *table= tc_pop_free_table(thd, element, k))
+        return table;
+    }
+    mysql_mutex_lock(&tc[i].LOCK_table_cache);
+  }
+  tc[i].check_contention(waited, n_instances, i);
+  return tc_pop_free_table(thd, element, i);
+}
+
+
 /**
   Release TABLE object to table cache.
 
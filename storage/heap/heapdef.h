@@ -100,6 +100,12 @@ extern void hp_clear(HP_SHARE *info);
 extern void hp_clear_keys(HP_SHARE *info);
 extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
                            key_part_map keypart_map);
+extern int hp_write_blobs(HP_INFO *info, const uchar *record);
+extern void hp_free_new_blobs(HP_INFO *info);
+extern void hp_store_blobs(HP_INFO *info, uchar *pos);
+extern void hp_free_blobs(HP_SHARE *share, const uchar *pos);
+extern int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos);
+extern int hp_rec_cmp(HP_SHARE *share, const uchar *pos, const uchar *record);
 
 extern mysql_mutex_t THR_LOCK_heap;
 
@@ -107,6 +113,7 @@ extern PSI_memory_key hp_key_memory_HP_SHARE;
 extern PSI_memory_key hp_key_memory_HP_INFO;
 extern PSI_memory_key hp_key_memory_HP_PTRS;
 extern PSI_memory_key hp_key_memory_HP_KEYDEF;
+extern PSI_memory_key hp_key_memory_HP_BLOB;
 
 #ifdef HAVE_PSI_INTERFACE
 void init_heap_psi_keys();
@@ -0,0 +1,274 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Storage of BLOB columns in heap-database
+
+  The data of each blob is copied into a chain of blocks of
+  HP_BLOB_CHUNK_SIZE bytes in share->blob_block. Free blocks are
+  linked from share->blob_del_link. Records that are read are
+  copied to the caller with the blob data in info->blob_buff, so
+  that the caller never points into the table.
+*/
+
+#include "heapdef.h"
+
+#define HP_BLOB_CHUNK_DATA (HP_BLOB_CHUNK_SIZE - sizeof(uchar*))
+
+static ulong hp_blob_length(const HP_BLOB_DESC *desc, const uchar *pos)
+{
+  switch (desc->packlength) {
+  case 1:
+    return (ulong) *pos;
+  case 2:
+    return (ulong) uint2korr(pos);
+  case 3:
+    return (ulong) uint3korr(pos);
+  case 4:
+    return (ulong) uint4korr(pos);
+  default:
+    DBUG_ASSERT(0);
+  }
+  return 0;
+}
+
+static inline uchar *hp_blob_ptr(const HP_BLOB_DESC *desc, const uchar *record)
+{
+  uchar *ptr;
+  memcpy(&ptr, record + desc->offset + desc->packlength, sizeof(ptr));
+  return ptr;
+}
+
+static inline void hp_set_blob_ptr(const HP_BLOB_DESC *desc, uchar *record,
+                                   const uchar *ptr)
+{
+  memcpy(record + desc->offset + desc->packlength, &ptr, sizeof(ptr));
+}
+
+
+	/* Find a free block for blob data */
+
+static uchar *hp_alloc_blob_chunk(HP_SHARE *share)
+{
+  ulong block_pos;
+  uchar *pos;
+  size_t length;
+
+  if ((pos= share->blob_del_link))
+  {
+    share->blob_del_link= *((uchar**) pos);
+    return pos;
+  }
+  if (share->data_length + share->index_length >= share->max_table_size)
+  {
+    my_errno= HA_ERR_RECORD_FILE_FULL;
+    return NULL;
+  }
+  if (!(block_pos= share->blob_chunks % share->blob_block.records_in_block))
+  {
+    if (hp_get_new_block(share, &share->blob_block, &length))
+      return NULL;
+    share->data_length+= length;
+  }
+  share->blob_chunks++;
+  return ((uchar*) share->blob_block.level_info[0].last_blocks +
+          block_pos * share->blob_block.recbuffer);
+}
+
+
+static void hp_free_blob_chain(HP_SHARE *share, uchar *pos)
+{
+  while (pos)
+  {
+    uchar *next= *((uchar**) pos);
+    *((uchar**) pos)= share->blob_del_link;
+    share->blob_del_link= pos;
+    pos= next;
+  }
+}
+
+
+/*
+  Copy the blobs of a record to new chains of blocks
+
+  SYNOPSIS
+    hp_write_blobs()
+    info		Heap handler
+    record		Record with the blobs to store
+
+  DESCRIPTION
+    The first block of each chain is stored in info->blob_chains.
+    On error no blocks are allocated.
+
+  RETURN
+    0      ok
+    other  error code
+*/
+
+int hp_write_blobs(HP_INFO *info, const uchar *record)
+{
+  HP_SHARE *share= info->s;
+  uint i;
+
+  for (i= 0; i < share->blobs; i++)
+  {
+    const HP_BLOB_DESC *desc= share->blob_descs + i;
+    ulong length= hp_blob_length(desc, record + desc->offset);
+    const uchar *data= hp_blob_ptr(desc, record);
+    uchar **next= info->blob_chains + i;
+
+    while (length)
+    {
+      uchar *chunk;
+      ulong n= MY_MIN(length, HP_BLOB_CHUNK_DATA);
+
+      if (!(chunk= hp_alloc_blob_chunk(share)))
+      {
+        *next= 0;
+        do
+          hp_free_blob_chain(share, info->blob_chains[i]);
+        while (i--);
+        return my_errno;
+      }
+      *next= chunk;
+      next= (uchar**) chunk;
+      memcpy(chunk + sizeof(uchar*), data, n);
+      data+= n;
+      length-= n;
+    }
+    *next= 0;
+  }
+  return 0;
+}
+
+
+	/* Free the chains that hp_write_blobs() allocated */
+
+void hp_free_new_blobs(HP_INFO *info)
+{
+  uint i;
+  for (i= 0; i < info->s->blobs; i++)
+    hp_free_blob_chain(info->s, info->blob_chains[i]);
+}
+
+
+	/* Store the chains of hp_write_blobs() in a stored record */
+
+void hp_store_blobs(HP_INFO *info, uchar *pos)
+{
+  uint i;
+  for (i= 0; i < info->s->blobs; i++)
+    hp_set_blob_ptr(info->s->blob_descs + i, pos, info->blob_chains[i]);
+}
+
+
+	/* Free the blob chains of a stored record */
+
+void hp_free_blobs(HP_SHARE *share, const uchar *pos)
+{
+  uint i;
+  for (i= 0; i < share->blobs; i++)
+    hp_free_blob_chain(share, hp_blob_ptr(share->blob_descs + i, pos));
+}
+
+
+/*
+  Copy a stored record to the caller
+
+  SYNOPSIS
+    hp_extract_record()
+    info		Heap handler
+    record		Store the record here
+    pos			The stored record
+
+  DESCRIPTION
+    The blobs are copied to info->blob_buff, which is valid until
+    the next record is read with the handler.
+
+  RETURN
+    0      ok
+    other  error code
+*/
+
+int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  size_t total= 0;
+  uchar *to;
+  uint i;
+
+  memcpy(record, pos, (size_t) share->reclength);
+  if (!share->blobs)
+    return 0;
+
+  for (i= 0; i < share->blobs; i++)
+  {
+    const HP_BLOB_DESC *desc= share->blob_descs + i;
+    total+= hp_blob_length(desc, pos + desc->offset);
+  }
+  if (total > info->blob_buff_length)
+  {
+    uchar *buff= (uchar*) my_realloc(hp_key_memory_HP_BLOB, info->blob_buff,
+                                     total,
+                                     MYF(MY_WME | MY_ALLOW_ZERO_PTR |
+                                         (share->internal ?
+                                          MY_THREAD_SPECIFIC : 0)));
+    if (!buff)
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    info->blob_buff= buff;
+    info->blob_buff_length= total;
+  }
+
+  for (i= 0, to= info->blob_buff; i < share->blobs; i++)
+  {
+    const HP_BLOB_DESC *desc= share->blob_descs + i;
+    ulong length= hp_blob_length(desc, pos + desc->offset);
+    const uchar *chunk= hp_blob_ptr(desc, pos);
+
+    hp_set_blob_ptr(desc, record, length ? to : NULL);
+    for (; length; chunk= *((uchar**) chunk))
+    {
+      ulong n= MY_MIN(length, HP_BLOB_CHUNK_DATA);
+      memcpy(to, chunk + sizeof(uchar*), n);
+      to+= n;
+      length-= n;
+    }
+  }
+  return 0;
+}
+
+
+/*
+  Compare a record with a stored record, except the blob pointers
+
+  RETURN
+    0      the records are equal
+    other  the records differ
+*/
+
+int hp_rec_cmp(HP_SHARE *share, const uchar *pos, const uchar *record)
+{
+  uint i, start= 0;
+
+  for (i= 0; i < share->blobs; i++)
+  {
+    const HP_BLOB_DESC *desc= share->blob_descs + i;
+    uint end= desc->offset + desc->packlength;
+    if (memcmp(pos + start, record + start, end - start))
+      return 1;
+    start= end + sizeof(uchar*);
+  }
+  return memcmp(pos + start, record + start, share->reclength - start);
+}
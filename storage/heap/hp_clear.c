@@ -35,6 +35,12 @@ void hp_clear(HP_SHARE *info)
     (void) hp_free_level(&info->block,info->block.levels,info->block.root,
 			(uchar*) 0);
   info->block.levels=0;
+  if (info->blob_block.levels)
+    (void) hp_free_level(&info->blob_block,info->blob_block.levels,
+                         info->blob_block.root,(uchar*) 0);
+  info->blob_block.levels=0;
+  info->blob_del_link=0;
+  info->blob_chunks=0;
   hp_clear_keys(info);
   info->records= info->deleted= 0;
   info->data_length= 0;
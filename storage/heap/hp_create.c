@@ -17,6 +17,7 @@
 #include "heapdef.h"
 
 static int keys_compare(heap_rb_param *param, uchar *key1, uchar *key2);
+static my_bool hp_binary_seg(HA_KEYSEG *seg);
 static void init_block(HP_BLOCK *block,uint reclength,ulong min_records,
 		       ulong max_records);
 
@@ -67,6 +68,7 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     {
       bzero((char*) &keyinfo->block,sizeof(keyinfo->block));
       bzero((char*) &keyinfo->rb_tree ,sizeof(keyinfo->rb_tree));
+      keyinfo->binary_hash= keyinfo->algorithm != HA_KEY_ALG_BTREE;
       for (j= length= 0; j < keyinfo->keysegs; j++)
       {
 	length+= keyinfo->seg[j].length;
@@ -141,6 +143,8 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
 	default:
 	  break;
 	}
+        if (!hp_binary_seg(keyinfo->seg + j))
+          keyinfo->binary_hash= 0;
       }
       keyinfo->length= length;
       length+= keyinfo->rb_tree.size_of_element + 
@@ -162,7 +166,8 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     if (!(share= (HP_SHARE*) my_malloc(hp_key_memory_HP_SHARE,
                                        sizeof(HP_SHARE)+
 				       keys*sizeof(HP_KEYDEF)+
-				       key_segs*sizeof(HA_KEYSEG),
+				       key_segs*sizeof(HA_KEYSEG)+
+				       create_info->blobs*sizeof(HP_BLOB_DESC),
 				       MYF(MY_ZEROFILL |
                                            (create_info->internal_table ?
                                             MY_THREAD_SPECIFIC : 0)))))
@@ -170,7 +175,21 @@ int heap_create(const char *name, HP_CREATE_INFO *create_info,
     share->keydef= (HP_KEYDEF*) (share + 1);
     share->key_stat_version= 1;
     keyseg= (HA_KEYSEG*) (share->keydef + keys);
+    share->blob_descs= (HP_BLOB_DESC*) (keyseg + key_segs);
     init_block(&share->block, visible_offset + 1, min_records, max_records);
+    if ((share->blobs= create_info->blobs))
+    {
+      memcpy(share->blob_descs, create_info->blob_descs,
+             (size_t) (sizeof(HP_BLOB_DESC) * share->blobs));
+      /*
+        Allocate at most a quarter of max_table_size at a time, so that
+        a small table can store any blobs.
+      */
+      init_block(&share->blob_block, HP_BLOB_CHUNK_SIZE, 0,
+                 (ulong) MY_MAX(MY_MIN(create_info->max_table_size /
+                                       (HP_BLOB_CHUNK_SIZE * 4),
+                                       max_records), HP_MIN_RECORDS_IN_BLOCK));
+    }
 	/* Fix keys */
     memcpy(share->keydef, keydef, (size_t) (sizeof(keydef[0]) * keys));
     for (i= 0, keyinfo= share->keydef; i < keys; i++, keyinfo++)
@@ -262,6 +281,30 @@ static int keys_compare(heap_rb_param *param, uchar *key1, uchar *key2)
 		    param->search_flag, not_used);
 }
 
+/*
+  Check if a key segment can be hashed and compared as bytes
+
+  Integer, float and binary segments qualify as is. Text segments
+  qualify if the collation is a binary one for a single byte
+  character set, in which case only trailing spaces can make
+  different strings equal.
+*/
+
+static my_bool hp_binary_seg(HA_KEYSEG *seg)
+{
+  switch (seg->type) {
+  case HA_KEYTYPE_TEXT:
+  case HA_KEYTYPE_VARTEXT1:
+    return (seg->charset->mbmaxlen == 1 &&
+            (seg->charset->state & MY_CS_BINSORT));
+  case HA_KEYTYPE_BIT:
+    return !seg->bit_length;
+  default:
+    return 1;
+  }
+}
+
+
 static void init_block(HP_BLOCK *block, uint reclength, ulong min_records,
 		       ulong max_records)
 {
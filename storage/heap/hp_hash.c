@@ -220,6 +220,111 @@ void hp_movelink(HASH_INFO *pos, HASH_INFO *next_link, HASH_INFO *newlink)
   return;
 }
 
+/*
+  Length of a string in a binary key segment, without the trailing
+  spaces that PAD SPACE collations ignore
+*/
+
+static inline size_t hp_binary_length(HA_KEYSEG *seg, const uchar *pos,
+                                      size_t length)
+{
+  if (!(seg->charset->state & MY_CS_NOPAD))
+  {
+    while (length >= 8 && uint8korr(pos + length - 8) == 0x2020202020202020ULL)
+      length-= 8;
+    while (length && pos[length - 1] == ' ')
+      length--;
+  }
+  return length;
+}
+
+
+/*
+  Calc hashvalue for a key with only binary segments
+
+  See hp_binary_seg(). The bytes of each segment are hashed with
+  my_crc32c(), which is hardware accelerated where the CPU has support
+  for it. Must give the same value as hp_rec_binary_hashnr().
+*/
+
+static ulong hp_binary_hashnr(HP_KEYDEF *keydef, const uchar *key)
+{
+  uint32 nr= 1;
+  HA_KEYSEG *seg,*endseg;
+
+  for (seg=keydef->seg,endseg=seg+keydef->keysegs ; seg < endseg ; seg++)
+  {
+    const uchar *pos= key;
+    size_t length= seg->length;
+    key+= seg->length;
+    if (seg->null_bit)
+    {
+      key++;
+      if (*pos++)
+      {
+        nr^= (nr << 1) | 1;
+        if (seg->type == HA_KEYTYPE_VARTEXT1)
+          key+= 2;
+        continue;
+      }
+    }
+    if (seg->type == HA_KEYTYPE_VARTEXT1)
+    {
+      length= uint2korr(pos);
+      set_if_smaller(length, seg->length);
+      pos+= 2;
+      key+= 2;
+      length= hp_binary_length(seg, pos, length);
+    }
+    else if (seg->type == HA_KEYTYPE_TEXT)
+      length= hp_binary_length(seg, pos, length);
+    nr= my_crc32c(nr, pos, length);
+  }
+  return (ulong) nr;
+}
+
+
+static ulong hp_rec_binary_hashnr(HP_KEYDEF *keydef, const uchar *rec)
+{
+  uint32 nr= 1;
+  HA_KEYSEG *seg,*endseg;
+
+  for (seg=keydef->seg,endseg=seg+keydef->keysegs ; seg < endseg ; seg++)
+  {
+    const uchar *pos= rec + seg->start;
+    size_t length= seg->length;
+    if (seg->null_bit && (rec[seg->null_pos] & seg->null_bit))
+    {
+      nr^= (nr << 1) | 1;
+      continue;
+    }
+    if (seg->type == HA_KEYTYPE_VARTEXT1)
+    {
+      length= seg->bit_start == 1 ? (size_t) *pos : uint2korr(pos);
+      set_if_smaller(length, seg->length);
+      pos+= seg->bit_start;
+      length= hp_binary_length(seg, pos, length);
+    }
+    else if (seg->type == HA_KEYTYPE_TEXT)
+      length= hp_binary_length(seg, pos, length);
+    nr= my_crc32c(nr, pos, length);
+  }
+  return (ulong) nr;
+}
+
+
+	/* Compare two strings of a binary key segment */
+
+static inline int hp_binary_cmp(HA_KEYSEG *seg,
+                                const uchar *pos1, size_t length1,
+                                const uchar *pos2, size_t length2)
+{
+  length1= hp_binary_length(seg, pos1, length1);
+  length2= hp_binary_length(seg, pos2, length2);
+  return length1 != length2 || memcmp(pos1, pos2, length1);
+}
+
+
 	/* Calc hashvalue for a key */
 
 static ulong hp_hashnr(HP_KEYDEF *keydef, const uchar *key)
@@ -228,6 +333,9 @@ static ulong hp_hashnr(HP_KEYDEF *keydef, const uchar *key)
   ulong nr=1, nr2=4;
   HA_KEYSEG *seg,*endseg;
 
+  if (keydef->binary_hash)
+    return hp_binary_hashnr(keydef, key);
+
   for (seg=keydef->seg,endseg=seg+keydef->keysegs ; seg < endseg ; seg++)
   {
     uchar *pos=(uchar*) key;
@@ -295,6 +403,9 @@ ulong hp_rec_hashnr(register HP_KEYDEF *keydef, register const uchar *rec)
   ulong nr=1, nr2=4;
   HA_KEYSEG *seg,*endseg;
 
+  if (keydef->binary_hash)
+    return hp_rec_binary_hashnr(keydef, rec);
+
   for (seg=keydef->seg,endseg=seg+keydef->keysegs ; seg < endseg ; seg++)
   {
     uchar *pos=(uchar*) rec+seg->start,*end=pos+seg->length;
@@ -399,6 +510,12 @@ int hp_rec_key_cmp(HP_KEYDEF *keydef, const uchar *rec1, const uchar *rec2)
       size_t char_length2;
       uchar *pos1= (uchar*)rec1 + seg->start;
       uchar *pos2= (uchar*)rec2 + seg->start;
+      if (keydef->binary_hash)
+      {
+        if (hp_binary_cmp(seg, pos1, seg->length, pos2, seg->length))
+          return 1;
+        continue;
+      }
       if (cs->mbmaxlen > 1)
       {
         size_t char_length= seg->length / cs->mbmaxlen;
@@ -435,6 +552,14 @@ int hp_rec_key_cmp(HP_KEYDEF *keydef, const uchar *rec1, const uchar *rec2)
         pos1+= 2;
         pos2+= 2;
       }
+      if (keydef->binary_hash)
+      {
+        set_if_smaller(char_length1, seg->length);
+        set_if_smaller(char_length2, seg->length);
+        if (hp_binary_cmp(seg, pos1, char_length1, pos2, char_length2))
+          return 1;
+        continue;
+      }
       if (cs->mbmaxlen > 1)
       {
         size_t safe_length1= char_length1;
@@ -505,6 +630,12 @@ int hp_key_cmp(HP_KEYDEF *keydef, const uchar *rec, const uchar *key)
       size_t char_length_key;
       size_t char_length_rec;
       uchar *pos= (uchar*) rec + seg->start;
+      if (keydef->binary_hash)
+      {
+        if (hp_binary_cmp(seg, pos, seg->length, key, seg->length))
+          return 1;
+        continue;
+      }
       if (cs->mbmaxlen > 1)
       {
         size_t char_length= seg->length / cs->mbmaxlen;
@@ -535,6 +666,13 @@ int hp_key_cmp(HP_KEYDEF *keydef, const uchar *rec, const uchar *key)
       size_t char_length_key= uint2korr(key);
       pos+= pack_length;
       key+= 2;                                  /* skip key pack length */
+      if (keydef->binary_hash)
+      {
+        set_if_smaller(char_length_rec, seg->length);
+        if (hp_binary_cmp(seg, pos, char_length_rec, key, char_length_key))
+          return 1;
+        continue;
+      }
       if (cs->mbmaxlen > 1)
       {
         size_t char_length1, char_length2;
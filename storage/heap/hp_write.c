@@ -42,8 +42,13 @@ int heap_write(HP_INFO *info, const uchar *record)
     DBUG_RETURN(my_errno=EACCES);
   }
 #endif
+  if (share->blobs && hp_write_blobs(info, record))
+    DBUG_RETURN(my_errno);
   if (!(pos=next_free_record_pos(share)))
+  {
+    hp_free_new_blobs(info);
     DBUG_RETURN(my_errno);
+  }
   share->changed=1;
 
   for (keydef = share->keydef, end = keydef + share->keys; keydef < end;
@@ -54,6 +59,8 @@ int heap_write(HP_INFO *info, const uchar *record)
   }
 
   memcpy(pos,record,(size_t) share->reclength);
+  if (share->blobs)
+    hp_store_blobs(info, pos);
   pos[share->visible]= 1;                     /* Mark record as not deleted */
   if (++share->records == share->blength)
     share->blength+= share->blength;
@@ -87,6 +94,7 @@ int heap_write(HP_INFO *info, const uchar *record)
     keydef--;
   } 
 
+  hp_free_new_blobs(info);
   share->deleted++;
   *((uchar**) pos)=share->del_link;
   share->del_link=pos;
@@ -28,6 +28,8 @@ Created 2/23/1996 Heikki Tuuri
 #include "ut0byte.h"
 #include "rem0cmp.h"
 #include "trx0trx.h"
+#include "buf0rea.h"
+#include "srv0srv.h"
 
 /**************************************************************//**
 Resets a persistent cursor object, freeing ::old_rec_buf if it is
@@ -46,6 +48,7 @@ btr_pcur_reset(
 
 	cursor->latch_mode = BTR_NO_LATCHES;
 	cursor->pos_state = BTR_PCUR_NOT_POSITIONED;
+	cursor->ra_last = FIL_NULL;
 }
 
 /**************************************************************//**
@@ -432,6 +435,79 @@ btr_pcur_t::restore_position(btr_latch_mode restore_latch_mode, mtr_t *mtr)
 	return ret_val;
 }
 
+/** Note that a persistent cursor moved to a sibling leaf page, and read
+ahead the pages that the cursor is likely to move to next
+(innodb_read_ahead_pages).
+
+Unlike buf_read_ahead_linear(), this follows the moves of one cursor,
+so that backward scans and scans whose leaf pages are a fixed number of
+pages apart are detected as well, and nothing is read for a cursor that
+does not keep moving to the sibling pages. If the page numbers of the
+last moves differed by the same amount, the following pages of that
+pattern are read; otherwise only the sibling of the new page is read.
+
+@param cursor  persistent cursor
+@param from    the page that the cursor moved from
+@param block   the page that the cursor moved to
+@param ahead   the sibling of block in the direction of the move */
+static void btr_pcur_read_ahead(btr_pcur_t *cursor, uint32_t from,
+                                const buf_block_t &block, uint32_t ahead)
+{
+  const uint32_t to= block.page.id().page_no();
+  const int32_t stride= int32_t(to - from);
+
+  if (from != cursor->ra_last)
+  {
+    /* The cursor was positioned on the page by a search */
+    cursor->ra_moves= 0;
+    cursor->ra_streak= 0;
+    cursor->ra_stride= stride;
+    cursor->ra_horizon= FIL_NULL;
+  }
+  else
+  {
+    if (cursor->ra_moves < UINT16_MAX)
+      cursor->ra_moves++;
+    if (stride != cursor->ra_stride)
+    {
+      cursor->ra_stride= stride;
+      cursor->ra_streak= 0;
+      cursor->ra_horizon= FIL_NULL;
+    }
+    else if (cursor->ra_streak < UINT16_MAX)
+      cursor->ra_streak++;
+  }
+  cursor->ra_last= to;
+
+  const ulint n= srv_read_ahead_pages;
+  if (!n || cursor->ra_moves < 2 || ahead == FIL_NULL ||
+      cursor->index()->is_ibuf())
+    return;
+
+  fil_space_t *space= cursor->index()->table->space;
+
+  if (cursor->ra_streak < 2 || ahead != to + uint32_t(stride))
+  {
+    /* The leaf pages are not in a regular pattern */
+    cursor->ra_horizon= FIL_NULL;
+    buf_read_ahead_pages(space, ahead, 1, 1, block.zip_size());
+    return;
+  }
+
+  /* Skip the pages that were read ahead in the previous moves */
+  int64_t k= 1;
+  if (cursor->ra_horizon != FIL_NULL)
+    k= std::max<int64_t>(k, (int64_t{cursor->ra_horizon} - to) / stride + 1);
+  if (k > int64_t(n))
+    return;
+
+  const int64_t horizon= int64_t{to} + int64_t(n) * stride;
+  cursor->ra_horizon= horizon > 0 && horizon < FIL_NULL
+    ? uint32_t(horizon) : FIL_NULL;
+  buf_read_ahead_pages(space, uint32_t(to + k * stride), stride,
+                       ulint(int64_t(n) - k + 1), block.zip_size());
+}
+
 /*********************************************************//**
 Moves the persistent cursor to the first record on the next page. Releases the
 latch on the current page, and bufferunfixes it. Note that there must not be
@@ -494,8 +570,14 @@ btr_pcur_move_to_next_page(
 
 	ut_d(page_check_dir(next_page));
 
+	const uint32_t page_no = page_get_page_no(page);
 	const auto s = mtr->get_savepoint();
 	mtr->rollback_to_savepoint(s - 2, s - 1);
+
+	if (page_is_leaf(next_page)) {
+		btr_pcur_read_ahead(cursor, page_no, *next_block,
+				    btr_page_get_next(next_page));
+	}
 	return DB_SUCCESS;
 }
 
@@ -523,6 +605,8 @@ btr_pcur_move_backward_from_page(
 	const auto latch_mode = cursor->latch_mode;
 	ut_ad(latch_mode == BTR_SEARCH_LEAF || latch_mode == BTR_MODIFY_LEAF);
 
+	const uint32_t page_no = btr_pcur_get_block(cursor)->page.id()
+		.page_no();
 	btr_pcur_store_position(cursor, mtr);
 
 	mtr_commit(mtr);
@@ -539,10 +623,12 @@ btr_pcur_move_backward_from_page(
 	}
 
 	buf_block_t* release_block = nullptr;
+	const buf_block_t* prev_block = nullptr;
 
 	if (!page_has_prev(btr_pcur_get_page(cursor))) {
 	} else if (btr_pcur_is_before_first_on_page(cursor)) {
 		release_block = btr_pcur_get_block(cursor);
+		prev_block = cursor->btr_cur.left_block;
 		page_cur_set_after_last(cursor->btr_cur.left_block,
 					btr_pcur_get_page_cur(cursor));
 	} else {
@@ -558,6 +644,10 @@ btr_pcur_move_backward_from_page(
 	if (release_block) {
 		mtr->release(*release_block);
 	}
+	if (prev_block) {
+		btr_pcur_read_ahead(cursor, page_no, *prev_block,
+				    btr_page_get_prev(prev_block->page.frame));
+	}
 	return false;
 }
 
@@ -40,6 +40,7 @@ Created 2/17/1996 Heikki Tuuri
 #include "btr0pcur.h"
 #include "btr0btr.h"
 #include "srv0mon.h"
+#include <thread>
 
 /** Is search system enabled.
 Search system is protected by array of latches. */
@@ -62,6 +63,27 @@ mysql_pfs_key_t	btr_search_latch_key;
 /** The adaptive hash index */
 btr_search_sys_t btr_search_sys;
 
+/** Source of btr_search_reader_slot */
+static std::atomic<ulint> btr_search_n_reader_slots;
+
+/** btr_search_sys_t::readers[] of the current thread */
+static thread_local const ulint btr_search_reader_slot=
+  btr_search_n_reader_slots.fetch_add(1, std::memory_order_relaxed) %
+  btr_search_sys_t::N_READER_SLOTS;
+
+std::atomic<uint32_t> &btr_search_sys_t::reader()
+{
+  return readers[btr_search_reader_slot].n;
+}
+
+void btr_search_sys_t::wait_for_readers() const
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  for (const reader_slot &slot : readers)
+    while (slot.n.load(std::memory_order_seq_cst))
+      std::this_thread::yield();
+}
+
 /** If the number of records on the page divided by this parameter
 would have been successfully accessed using a hash index, the index
 is then built on the page, assuming the global limit has been reached */
@@ -261,6 +283,10 @@ void btr_search_disable()
 	/* Set all block->index = NULL. */
 	buf_pool.clear_hash_index();
 
+	/* Wait for btr_search_guess_on_hash() that could be accessing
+	the hash tables without a partition latch. */
+	btr_search_sys.wait_for_readers();
+
 	/* Clear the adaptive hash index. */
 	btr_search_sys.clear();
 
@@ -470,14 +496,13 @@ __attribute__((nonnull))
 Insert an entry into the hash table. If an entry with the same fold number
 is found, its node is updated to point to the new data, and no new node
 is inserted.
-@param table hash table
-@param heap  memory heap
+@param part  hash index partition
 @param fold  folded value of the record
 @param block buffer block containing the record
 @param data  the record
 @retval true on success
 @retval false if no more memory could be allocated */
-static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
+static bool ha_insert_for_fold(btr_search_sys_t::partition *part,
                                ulint fold,
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
                                buf_block_t *block, /*!< buffer block of data */
@@ -489,7 +514,7 @@ static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
   ut_ad(btr_search_enabled);
 
-  hash_cell_t *cell= &table->array[table->calc_hash(fold)];
+  hash_cell_t *cell= &part->table.array[part->table.calc_hash(fold)];
 
   for (ha_node_t *prev= static_cast<ha_node_t*>(cell->node); prev;
        prev= prev->next)
@@ -510,9 +535,12 @@ static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
   }
 
   /* We have to allocate a new chain node */
-  ha_node_t *node= static_cast<ha_node_t*>(mem_heap_alloc(heap, sizeof *node));
+  ha_node_t *node= part->free_nodes;
 
-  if (!node)
+  if (node)
+    part->free_nodes= node->next;
+  else if (!(node= static_cast<ha_node_t*>(mem_heap_alloc(part->heap,
+                                                          sizeof *node))))
     return false;
 
   ha_node_set_data(node, block, data);
@@ -538,10 +566,9 @@ static bool ha_insert_for_fold(hash_table_t *table, mem_heap_t* heap,
 
 __attribute__((nonnull))
 /** Delete a record.
-@param table     hash table
-@param heap      memory heap
+@param part      hash index partition
 @param del_node  record to be deleted */
-static void ha_delete_hash_node(hash_table_t *table, mem_heap_t *heap,
+static void ha_delete_hash_node(btr_search_sys_t::partition *part,
                                 ha_node_t *del_node)
 {
   ut_ad(btr_search_enabled);
@@ -550,79 +577,69 @@ static void ha_delete_hash_node(hash_table_t *table, mem_heap_t *heap,
   ut_a(del_node->block->n_pointers-- < MAX_N_POINTERS);
 #endif /* UNIV_AHI_DEBUG || UNIV_DEBUG */
 
-  const ulint fold= del_node->fold;
+  hash_cell_t *cell= &part->table.array[part->table.calc_hash(del_node->fold)];
 
-  HASH_DELETE(ha_node_t, next, table, fold, del_node);
-
-  ha_node_t *top= static_cast<ha_node_t*>(mem_heap_get_top(heap, sizeof *top));
-
-  if (del_node != top)
+  /* Unlink del_node. btr_search_guess_latch_free() may be positioned
+  at del_node while traversing the chain without holding the latch. */
+  if (cell->node == del_node)
+    cell->node= del_node->next;
+  else
   {
-    /* Compact the heap of nodes by moving the top in the place of del_node. */
-    *del_node= *top;
-    hash_cell_t *cell= &table->array[table->calc_hash(top->fold)];
-
-    /* Look for the pointer to the top node, to update it */
-    if (cell->node == top)
-      /* The top node is the first in the chain */
-      cell->node= del_node;
-    else
-    {
-      /* We have to look for the predecessor */
-      ha_node_t *node= static_cast<ha_node_t*>(cell->node);
+    ha_node_t *node= static_cast<ha_node_t*>(cell->node);
 
-      while (top != HASH_GET_NEXT(next, node))
-        node= static_cast<ha_node_t*>(HASH_GET_NEXT(next, node));
-
-      /* Now we have the predecessor node */
-      node->next= del_node;
+    while (node->next != del_node)
+    {
+      node= node->next;
+      ut_a(node);
     }
+
+    node->next= del_node->next;
   }
 
-  /* Free the occupied space */
-  mem_heap_free_top(heap, sizeof *top);
+  /* The node will be reused by ha_insert_for_fold(). A lookup that is
+  positioned at del_node will continue into the free list or, after a
+  reuse, into another chain. That is harmless: the nodes are returned
+  to part->heap only by btr_search_disable(), which waits for such
+  lookups, so only ha_node_t objects will be accessed, and the result
+  will be discarded by read_validate(), because our exclusive latch
+  changed the sequence number of the partition. */
+  del_node->next= part->free_nodes;
+  part->free_nodes= del_node;
 }
 
 __attribute__((nonnull))
 /** Delete all pointers to a page.
-@param table     hash table
-@param heap      memory heap
+@param part      hash index partition
 @param page      record to be deleted */
-static void ha_remove_all_nodes_to_page(hash_table_t *table, mem_heap_t *heap,
+static void ha_remove_all_nodes_to_page(btr_search_sys_t::partition *part,
                                         ulint fold, const page_t *page)
 {
-  for (ha_node_t *node= ha_chain_get_first(table, fold); node; )
+  for (ha_node_t *node= ha_chain_get_first(&part->table, fold); node; )
   {
+    ha_node_t *next= ha_chain_get_next(node);
     if (page_align(ha_node_get_data(node)) == page)
-    {
-      ha_delete_hash_node(table, heap, node);
-      /* The deletion may compact the heap of nodes and move other nodes! */
-      node= ha_chain_get_first(table, fold);
-    }
-    else
-      node= ha_chain_get_next(node);
+      ha_delete_hash_node(part, node);
+    node= next;
   }
 #ifdef UNIV_DEBUG
   /* Check that all nodes really got deleted */
-  for (ha_node_t *node= ha_chain_get_first(table, fold); node;
+  for (ha_node_t *node= ha_chain_get_first(&part->table, fold); node;
        node= ha_chain_get_next(node))
     ut_ad(page_align(ha_node_get_data(node)) != page);
 #endif /* UNIV_DEBUG */
 }
 
 /** Delete a record if found.
-@param table     hash table
-@param heap      memory heap for the hash bucket chain
+@param part      hash index partition
 @param fold      folded value of the searched data
 @param data      pointer to the record
 @return whether the record was found */
-static bool ha_search_and_delete_if_found(hash_table_t *table,
-                                          mem_heap_t *heap,
+static bool ha_search_and_delete_if_found(btr_search_sys_t::partition *part,
                                           ulint fold, const rec_t *data)
 {
-  if (ha_node_t *node= ha_search_with_data(table, fold, data))
+  if (ha_node_t *node= ha_search_with_data(&part->table, fold, data))
   {
-    ha_delete_hash_node(table, heap, node);
+    ha_delete_hash_node(part, node);
     return true;
   }
 
@@ -669,7 +686,7 @@ static bool ha_search_and_update_if_found(hash_table_t *table, ulint fold,
 
 #if defined UNIV_AHI_DEBUG || defined UNIV_DEBUG
 #else
-# define ha_insert_for_fold(t,h,f,b,d) ha_insert_for_fold(t,h,f,d)
+# define ha_insert_for_fold(p,f,b,d) ha_insert_for_fold(p,f,d)
 # define ha_search_and_update_if_found(table,fold,data,new_block,new_data) \
 	ha_search_and_update_if_found(table,fold,data,new_data)
 #endif
@@ -743,7 +760,7 @@ btr_search_update_hash_ref(
 			mem_heap_free(heap);
 		}
 
-		ha_insert_for_fold(&part->table, part->heap, fold, block, rec);
+		ha_insert_for_fold(part, fold, block, rec);
 
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -1022,14 +1039,125 @@ inline buf_block_t* buf_pool_t::block_from_ahi(const byte *ptr) const
   /* buf_pool_t::chunk_t::init() invokes buf_block_init() so that
   block[n].frame == block->page.frame + n * srv_page_size.  Check it. */
   ut_ad(block->page.frame == page_align(ptr));
-  /* Read the state of the block without holding hash_lock.
-  A state transition to REMOVE_HASH is possible during
-  this execution. */
-  ut_ad(block->page.state() >= buf_page_t::REMOVE_HASH);
-
   return block;
 }
 
+/** Look for an element in a hash table without holding the latch.
+The chain may be modified concurrently, and the result must be checked
+with btr_search_latch::read_validate(). Because ha_delete_hash_node()
+does not return nodes to the memory heap, only ha_node_t objects will
+be accessed. A concurrent reuse of a node could make us skip to another
+chain or into a cycle; hence the traversal is bounded.
+@param table  hash table
+@param fold   folded value of the searched data
+@param data   the data of the first node having the fold number, or nullptr
+@return whether the traversal completed */
+static bool ha_search_latch_free(const hash_table_t &table, ulint fold,
+                                 const rec_t *&data)
+{
+  const hash_cell_t *array= table.array;
+  const ha_node_t *node= static_cast<const ha_node_t*>
+    (array[table.calc_hash(fold)].node);
+
+  for (ulint n= 256; node; node= node->next)
+  {
+    if (node->fold == fold)
+    {
+      data= node->data;
+      return true;
+    }
+    if (!--n)
+      return false;
+  }
+
+  data= nullptr;
+  return true;
+}
+
+/** Outcome of btr_search_guess_latch_free() */
+enum btr_search_guess_t
+{
+  /** the block was found and latched */
+  BTR_SEARCH_GUESS_FOUND,
+  /** the hash index contains no matching entry */
+  BTR_SEARCH_GUESS_FAIL,
+  /** the lookup conflicted with a modification of the partition,
+  or the entry needs checks that require the partition latch */
+  BTR_SEARCH_GUESS_RETRY
+};
+
+/** Look up the adaptive hash index without acquiring the partition latch.
+The result is validated against the sequence number of the partition
+latch; btr_search_disable() will wait for us before freeing the hash
+table.
+@param part        adaptive hash index partition
+@param index       the index that is being searched
+@param fold        folded value of the search tuple
+@param latch_mode  BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param rec         the record that the hash index points to
+@param block       the block of rec, latched in latch_mode
+@return outcome */
+TRANSACTIONAL_TARGET static btr_search_guess_t
+btr_search_guess_latch_free(btr_search_sys_t::partition *part,
+                            const dict_index_t *index, ulint fold,
+                            ulint latch_mode,
+                            const rec_t *&rec, buf_block_t *&block)
+{
+  btr_search_guess_t result= BTR_SEARCH_GUESS_RETRY;
+  std::atomic<uint32_t> &reader= btr_search_sys.reader();
+  reader.fetch_add(1, std::memory_order_seq_cst);
+
+  const uint32_t seq= part->latch.read_begin();
+
+  if (seq & 1 || !btr_search_enabled ||
+      !ha_search_latch_free(part->table, fold, rec))
+    goto func_exit;
+
+  DEBUG_SYNC_C("btr_search_guess_latch_free");
+
+  if (!part->latch.read_validate(seq));
+  else if (!rec)
+    result= BTR_SEARCH_GUESS_FAIL;
+  else
+  {
+    block= buf_pool.block_from_ahi(rec);
+    buf_pool_t::hash_chain &chain= buf_pool.page_hash.cell_get(
+      block->page.id().fold());
+    bool got_latch;
+    {
+      transactional_shared_lock_guard<page_hash_latch> g{
+        buf_pool.page_hash.lock_get(chain)};
+      got_latch= latch_mode == BTR_SEARCH_LEAF
+        ? block->page.lock.s_lock_try()
+        : block->page.lock.x_lock_try();
+    }
+
+    if (!got_latch)
+      result= BTR_SEARCH_GUESS_FAIL;
+    else
+    {
+      const auto state= block->page.state();
+      /* If the block belongs to a freed index, let the caller deal
+      with it while holding the partition latch. */
+      if (state >= buf_page_t::UNFIXED && block->index == index &&
+          part->latch.read_validate(seq))
+      {
+        ut_ad(state < buf_page_t::READ_FIX || state >= buf_page_t::WRITE_FIX);
+        ut_ad(state < buf_page_t::READ_FIX || latch_mode == BTR_SEARCH_LEAF);
+        result= BTR_SEARCH_GUESS_FOUND;
+      }
+      else if (latch_mode == BTR_SEARCH_LEAF)
+        block->page.lock.s_unlock();
+      else
+        block->page.lock.x_unlock();
+    }
+  }
+
+func_exit:
+  reader.fetch_sub(1, std::memory_order_release);
+  return result;
+}
+
 /** Tries to guess the right search position based on the hash search info
 of the index. Note that if mode is PAGE_CUR_LE, which is used in inserts,
 and the function returns TRUE, then cursor->up_match and cursor->low_match
@@ -1096,6 +1224,17 @@ btr_search_guess_on_hash(
 
 	auto part = btr_search_sys.get_part(*index);
 	const rec_t* rec;
+	buf_block_t* block;
+
+	switch (btr_search_guess_latch_free(part, index, fold, latch_mode,
+					    rec, block)) {
+	case BTR_SEARCH_GUESS_FOUND:
+		goto got_block;
+	case BTR_SEARCH_GUESS_FAIL:
+		goto fail;
+	case BTR_SEARCH_GUESS_RETRY:
+		break;
+	}
 
 	part->latch.rd_lock(SRW_LOCK_CALL);
 
@@ -1114,43 +1253,54 @@ btr_search_guess_on_hash(
 		return false;
 	}
 
-	buf_block_t* block = buf_pool.block_from_ahi(rec);
+	block = buf_pool.block_from_ahi(rec);
+	/* Read the state of the block without holding hash_lock.
+	A state transition to REMOVE_HASH is possible during
+	this execution. */
+	ut_ad(block->page.state() >= buf_page_t::REMOVE_HASH);
 
-	buf_pool_t::hash_chain& chain = buf_pool.page_hash.cell_get(
-		block->page.id().fold());
-	bool got_latch;
 	{
-		transactional_shared_lock_guard<page_hash_latch> g{
-			buf_pool.page_hash.lock_get(chain)};
-		got_latch = (latch_mode == BTR_SEARCH_LEAF)
-			? block->page.lock.s_lock_try()
-			: block->page.lock.x_lock_try();
-	}
+		buf_pool_t::hash_chain& chain = buf_pool.page_hash.cell_get(
+			block->page.id().fold());
+		bool got_latch;
+		{
+			transactional_shared_lock_guard<page_hash_latch> g{
+				buf_pool.page_hash.lock_get(chain)};
+			got_latch = (latch_mode == BTR_SEARCH_LEAF)
+				? block->page.lock.s_lock_try()
+				: block->page.lock.x_lock_try();
+		}
 
-	if (!got_latch) {
-		goto ahi_release_and_fail;
-	}
+		if (!got_latch) {
+			goto ahi_release_and_fail;
+		}
 
-	const auto state = block->page.state();
-	if (UNIV_UNLIKELY(state < buf_page_t::UNFIXED)) {
-		ut_ad(state == buf_page_t::REMOVE_HASH);
+		const auto state = block->page.state();
+		if (UNIV_UNLIKELY(state < buf_page_t::UNFIXED)) {
+			ut_ad(state == buf_page_t::REMOVE_HASH);
 block_and_ahi_release_and_fail:
-		if (latch_mode == BTR_SEARCH_LEAF) {
-			block->page.lock.s_unlock();
-		} else {
-			block->page.lock.x_unlock();
+			if (latch_mode == BTR_SEARCH_LEAF) {
+				block->page.lock.s_unlock();
+			} else {
+				block->page.lock.x_unlock();
+			}
+			goto ahi_release_and_fail;
 		}
-		goto ahi_release_and_fail;
-	}
 
-	ut_ad(state < buf_page_t::READ_FIX || state >= buf_page_t::WRITE_FIX);
-	ut_ad(state < buf_page_t::READ_FIX || latch_mode == BTR_SEARCH_LEAF);
+		ut_ad(state < buf_page_t::READ_FIX
+		      || state >= buf_page_t::WRITE_FIX);
+		ut_ad(state < buf_page_t::READ_FIX
+		      || latch_mode == BTR_SEARCH_LEAF);
 
-	if (index != block->index && index_id == block->index->id) {
-		ut_a(block->index->freed());
-		goto block_and_ahi_release_and_fail;
+		if (index != block->index && index_id == block->index->id) {
+			ut_a(block->index->freed());
+			goto block_and_ahi_release_and_fail;
+		}
 	}
 
+	part->latch.rd_unlock();
+
+got_block:
 	block->page.fix();
 	block->page.set_accessed();
 	buf_page_make_young_if_needed(&block->page);
@@ -1159,8 +1309,6 @@ btr_search_guess_on_hash(
 	static_assert(ulint{MTR_MEMO_PAGE_X_FIX} == ulint{BTR_MODIFY_LEAF},
 		      "");
 
-	part->latch.rd_unlock();
-
 	++buf_pool.stat.n_page_gets;
 
 	mtr->memo_push(block, mtr_memo_type_t(latch_mode));
@@ -1375,8 +1523,7 @@ void btr_search_drop_page_hash_index(buf_block_t* block,
 	}
 
 	for (ulint i = 0; i < n_cached; i++) {
-		ha_remove_all_nodes_to_page(&part->table, part->heap,
-					    folds[i], page);
+		ha_remove_all_nodes_to_page(part, folds[i], page);
 	}
 
 	switch (index->search_info->ref_count--) {
@@ -1446,7 +1593,7 @@ void
 btr_search_build_page_hash_index(
 	dict_index_t*	index,
 	buf_block_t*	block,
-	srw_spin_lock*	ahi_latch,
+	btr_search_latch*	ahi_latch,
 	uint16_t	n_fields,
 	uint16_t	n_bytes,
 	bool		left_side)
@@ -1621,8 +1768,7 @@ btr_search_build_page_hash_index(
 	{
 		auto part = btr_search_sys.get_part(*index);
 		for (ulint i = 0; i < n_cached; i++) {
-			ha_insert_for_fold(&part->table, part->heap,
-					   folds[i], block, recs[i]);
+			ha_insert_for_fold(part, folds[i], block, recs[i]);
 		}
 	}
 
@@ -1644,8 +1790,8 @@ btr_search_build_page_hash_index(
 @param[in,out]	cursor	cursor which was just positioned */
 void btr_search_info_update_slow(btr_search_t *info, btr_cur_t *cursor)
 {
-	srw_spin_lock*	ahi_latch = &btr_search_sys.get_part(*cursor->index())
-		->latch;
+	btr_search_latch* ahi_latch = &btr_search_sys.get_part(
+		*cursor->index())->latch;
 	buf_block_t*	block = btr_cur_get_block(cursor);
 
 	/* NOTE that the following two function calls do NOT protect
@@ -1711,7 +1857,7 @@ btr_search_move_or_delete_hash_entries(
 	assert_block_ahi_valid(block);
 	assert_block_ahi_valid(new_block);
 
-	srw_spin_lock* ahi_latch = index
+	btr_search_latch* ahi_latch = index
 		? &btr_search_sys.get_part(*index)->latch
 		: nullptr;
 
@@ -1818,8 +1964,7 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor)
 	if (block->index && btr_search_enabled) {
 		ut_a(block->index == index);
 
-		if (ha_search_and_delete_if_found(&part->table, part->heap,
-						  fold, rec)) {
+		if (ha_search_and_delete_if_found(part, fold, rec)) {
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_REMOVED);
 		} else {
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_REMOVE_NOT_FOUND);
@@ -1837,7 +1982,7 @@ void btr_search_update_hash_on_delete(btr_cur_t *cursor)
 			inserted next to the cursor.
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
-                                           srw_spin_lock *ahi_latch)
+                                           btr_search_latch *ahi_latch)
 {
 	buf_block_t*	block;
 	dict_index_t*	index;
@@ -1913,7 +2058,7 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 				to the cursor
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_on_insert(btr_cur_t *cursor,
-                                      srw_spin_lock *ahi_latch)
+                                      btr_search_latch *ahi_latch)
 {
 	buf_block_t*	block;
 	dict_index_t*	index;
@@ -2007,8 +2152,7 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 			}
 
 			part = btr_search_sys.get_part(*index);
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(part, ins_fold, block, ins_rec);
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 		}
 
@@ -2029,11 +2173,9 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 		}
 
 		if (!left_side) {
-			ha_insert_for_fold(&part->table, part->heap,
-					   fold, block, rec);
+			ha_insert_for_fold(part, fold, block, rec);
 		} else {
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(part, ins_fold, block, ins_rec);
 		}
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -2053,8 +2195,7 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 				part = btr_search_sys.get_part(*index);
 			}
 
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(part, ins_fold, block, ins_rec);
 			MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 		}
 
@@ -2074,11 +2215,9 @@ void btr_search_update_hash_on_insert(btr_cur_t *cursor,
 		}
 
 		if (!left_side) {
-			ha_insert_for_fold(&part->table, part->heap,
-					   ins_fold, block, ins_rec);
+			ha_insert_for_fold(part, ins_fold, block, ins_rec);
 		} else {
-			ha_insert_for_fold(&part->table, part->heap,
-					   next_fold, block, next_rec);
+			ha_insert_for_fold(part, next_fold, block, next_rec);
 		}
 		MONITOR_INC(MONITOR_ADAPTIVE_HASH_ROW_ADDED);
 	}
@@ -74,6 +74,7 @@ using st_::span;
 #ifdef HAVE_LIBNUMA
 #include <numa.h>
 #include <numaif.h>
+#include <sched.h>
 struct set_numa_interleave_t
 {
 	set_numa_interleave_t()
@@ -111,6 +112,102 @@ struct set_numa_interleave_t
 };
 
 #define NUMA_MEMPOLICY_INTERLEAVE_IN_SCOPE set_numa_interleave_t scoped_numa
+
+void buf_pool_t::numa_create()
+{
+  numa_n_nodes= 0;
+
+  if (!srv_numa_local || numa_available() < 0)
+    return;
+
+  if (srv_numa_interleave)
+  {
+    ib::warn() << "innodb_numa_local is ignored because"
+                  " innodb_numa_interleave is set";
+    return;
+  }
+
+  struct bitmask *numa_mems_allowed= numa_get_mems_allowed();
+  const int max_node= numa_max_node();
+  ulint n= 0;
+
+  for (int node= 0; node <= max_node; node++)
+    n+= numa_bitmask_isbitset(numa_mems_allowed, node);
+
+  if (n > 1)
+  {
+    numa_nodes= static_cast<int*>(ut_malloc_nokey(n * sizeof *numa_nodes));
+    n= 0;
+    for (int node= 0; node <= max_node; node++)
+      if (numa_bitmask_isbitset(numa_mems_allowed, node))
+        numa_nodes[n++]= node;
+
+    numa_n_cpus= numa_num_configured_cpus();
+    numa_cpu_node= static_cast<byte*>(ut_malloc_nokey(numa_n_cpus));
+    for (int cpu= 0; cpu < numa_n_cpus; cpu++)
+    {
+      /* A CPU on a node without allowed memory is assigned
+      to one of the allowed nodes. */
+      const int node= numa_node_of_cpu(cpu);
+      ulint i= 0;
+      while (i < n && numa_nodes[i] != node)
+        i++;
+      numa_cpu_node[cpu]= byte(i < n ? i : cpu % n);
+    }
+
+    numa_n_nodes= n;
+    ib::info() << "Placing the buffer pool on " << n << " NUMA nodes";
+  }
+
+  numa_bitmask_free(numa_mems_allowed);
+}
+
+void buf_pool_t::numa_close()
+{
+  if (numa_n_nodes)
+  {
+    ut_free(numa_nodes);
+    ut_free(numa_cpu_node);
+    numa_nodes= nullptr;
+    numa_cpu_node= nullptr;
+    numa_n_nodes= 0;
+  }
+}
+
+ulint buf_pool_t::numa_local_node() const
+{
+  const int cpu= sched_getcpu();
+  return cpu >= 0 && cpu < numa_n_cpus ? numa_cpu_node[cpu] : 0;
+}
+
+void buf_pool_t::numa_bind(void *mem, size_t size) const
+{
+  ut_ad(numa_n_nodes);
+  struct bitmask *mask= numa_allocate_nodemask();
+  byte *start= static_cast<byte*>(mem);
+  byte *const end= start + size;
+
+  while (start < end)
+  {
+    byte *stripe_end= reinterpret_cast<byte*>
+      ((size_t(start) / NUMA_STRIPE + 1) * NUMA_STRIPE);
+    if (stripe_end > end)
+      stripe_end= end;
+    numa_bitmask_clearall(mask);
+    numa_bitmask_setbit(mask, numa_nodes[numa_node_of(start)]);
+    if (mbind(start, size_t(stripe_end - start), MPOL_PREFERRED,
+              mask->maskp, mask->size, MPOL_MF_MOVE))
+    {
+      ib::warn() << "Failed to set NUMA memory policy of"
+              " buffer pool page frames to MPOL_PREFERRED"
+              " (error: " << strerror(errno) << ").";
+      break;
+    }
+    start= stripe_end;
+  }
+
+  numa_bitmask_free(mask);
+}
 #else
 #define NUMA_MEMPOLICY_INTERLEAVE_IN_SCOPE
 #endif /* HAVE_LIBNUMA */
@@ -880,9 +977,10 @@ inline bool buf_pool_t::chunk_t::create(size_t bytes)
     }
     numa_bitmask_free(numa_mems_allowed);
   }
+  else if (buf_pool.numa_n_nodes)
+    buf_pool.numa_bind(mem, mem_size());
 #endif /* HAVE_LIBNUMA */
 
-
   /* Allocate the block descriptors from
   the start of the memory block. */
   blocks= reinterpret_cast<buf_block_t*>(mem);
@@ -921,14 +1019,34 @@ inline bool buf_pool_t::chunk_t::create(size_t bytes)
   for (auto i= size; i--; ) {
     buf_block_init(block, frame);
     MEM_UNDEFINED(block->page.frame, srv_page_size);
-    /* Add the block to the free list */
-    UT_LIST_ADD_LAST(buf_pool.free, &block->page);
-
-    ut_d(block->page.in_free_list = TRUE);
+#ifdef HAVE_LIBNUMA
+    if (!buf_pool.numa_n_nodes)
+#endif /* HAVE_LIBNUMA */
+    {
+      /* Add the block to the free list */
+      UT_LIST_ADD_LAST(buf_pool.free, &block->page);
+      ut_d(block->page.in_free_list = TRUE);
+    }
     block++;
     frame+= srv_page_size;
   }
 
+#ifdef HAVE_LIBNUMA
+  if (buf_pool.numa_n_nodes)
+  {
+    /* Add the blocks to the free list so that adjacent list elements
+    are from different NUMA stripes. Thus, buf_LRU_get_free_only()
+    will find a block on the node of the thread after a short scan. */
+    const size_t stripe_size= buf_pool_t::NUMA_STRIPE >> srv_page_size_shift;
+    for (size_t j= 0; j < stripe_size; j++)
+      for (size_t i= j; i < size; i+= stripe_size)
+      {
+        UT_LIST_ADD_LAST(buf_pool.free, &blocks[i].page);
+        ut_d(blocks[i].page.in_free_list= true);
+      }
+  }
+#endif /* HAVE_LIBNUMA */
+
   reg();
 
   return true;
@@ -1021,6 +1139,9 @@ bool buf_pool_t::create()
 
   chunks= static_cast<chunk_t*>(ut_zalloc_nokey(n_chunks * sizeof *chunks));
   UT_LIST_INIT(free, &buf_page_t::list);
+#ifdef HAVE_LIBNUMA
+  numa_create();
+#endif /* HAVE_LIBNUMA */
   curr_size= 0;
   auto chunk= chunks;
 
@@ -1039,6 +1160,9 @@ bool buf_pool_t::create()
       }
       ut_free(chunks);
       chunks= nullptr;
+#ifdef HAVE_LIBNUMA
+      numa_close();
+#endif /* HAVE_LIBNUMA */
       UT_DELETE(chunk_t::map_reg);
       chunk_t::map_reg= nullptr;
       aligned_free(const_cast<byte*>(field_ref_zero));
@@ -1160,6 +1284,9 @@ void buf_pool_t::close()
   chunks= nullptr;
   page_hash.free();
   zip_hash.free();
+#ifdef HAVE_LIBNUMA
+  numa_close();
+#endif /* HAVE_LIBNUMA */
 
   io_buf.close();
   UT_DELETE(chunk_t::map_reg);
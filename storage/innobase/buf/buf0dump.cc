@@ -33,7 +33,10 @@ Created April 08, 2011 Vasil Dimov
 
 #include "buf0buf.h"
 #include "buf0dump.h"
+#include "buf0rea.h"
 #include "dict0dict.h"
+#include "ibuf0ibuf.h"
+#include "mach0data.h"
 #include "os0file.h"
 #include "srv0srv.h"
 #include "srv0start.h"
@@ -60,6 +63,25 @@ static volatile bool	buf_load_should_start;
 
 static bool	buf_load_abort_flag;
 
+/** The first bytes of a buffer pool dump in the binary format.
+
+The magic is followed by the number of pages as an 8-byte integer and the
+page identifiers in ascending order. A page identifier is written as a
+variable-length integer (7 bits per byte, least significant first) of
+  (page_no - previous page_no) << 1, if the tablespace is the previous one,
+  (space_id - previous space_id) << 1 | 1, followed by page_no, otherwise.
+A page takes typically 1 or 2 bytes, while the text format, where every
+page is written as a line "space_id,page_no", takes about 10 to 20 bytes.
+
+Lines in the text format may follow the page identifiers, so that pages
+can still be appended to a dump by hand. A file that does not start with
+the magic is read in the text format. */
+static const byte buf_dump_magic[8]= {'I','B','P','O','O','L','0','1'};
+
+/** Number of buf_pool.LRU entries that buf_dump() visits while holding
+buf_pool.mutex */
+static constexpr ulint BUF_DUMP_CHUNK_PAGES = 1024;
+
 /** Start the buffer pool dump/load task and instructs it to start a dump. */
 void buf_dump_start()
 {
@@ -223,6 +245,19 @@ static void buf_dump_generate_path(char *path, size_t path_size)
 }
 
 
+/** Write an integer of the binary dump format.
+@param b  output buffer, at least 10 bytes
+@param n  the integer
+@return end of the written bytes */
+static byte *buf_dump_write_int(byte *b, uint64_t n)
+{
+	for (; n >= 0x80; n >>= 7) {
+		*b++ = byte(n | 0x80);
+	}
+	*b++ = byte(n);
+	return b;
+}
+
 /*****************************************************************//**
 Perform a buffer pool dump into the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -275,22 +310,16 @@ buf_dump(
 				tmp_filename, strerror(errno));
 		return;
 	}
-	const buf_page_t*	bpage;
-	page_id_t*		dump;
+	buf_page_t*		bpage;
+	page_id_t*		dump = nullptr;
 	ulint			n_pages;
-	ulint			j;
+	ulint			j = 0;
 
 	mysql_mutex_lock(&buf_pool.mutex);
 
 	n_pages = UT_LIST_GET_LEN(buf_pool.LRU);
 
-	/* skip empty buffer pools */
-	if (n_pages == 0) {
-		mysql_mutex_unlock(&buf_pool.mutex);
-		goto done;
-	}
-
-	if (srv_buf_pool_dump_pct != 100) {
+	if (n_pages && srv_buf_pool_dump_pct != 100) {
 		ulint		t_pages;
 
 		/* limit the number of total pages dumped to X% of the
@@ -310,12 +339,13 @@ buf_dump(
 		}
 	}
 
-	dump = static_cast<page_id_t*>(ut_malloc_nokey(
-					       n_pages * sizeof(*dump)));
+	mysql_mutex_unlock(&buf_pool.mutex);
 
-	if (dump == NULL) {
+	/* An empty buffer pool is dumped as a header without pages */
+	if (n_pages
+	    && !(dump = static_cast<page_id_t*>(ut_malloc_nokey(
+						     n_pages * sizeof *dump)))) {
 		std::ostringstream str_bytes;
-		mysql_mutex_unlock(&buf_pool.mutex);
 		fclose(f);
 		str_bytes << ib::bytes_iec{n_pages * sizeof(*dump)};
 		buf_dump_status(STATUS_ERR,
@@ -326,52 +356,97 @@ buf_dump(
 		return;
 	}
 
-	for (bpage = UT_LIST_GET_FIRST(buf_pool.LRU), j = 0;
-	     bpage != NULL && j < n_pages;
-	     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
-		const auto status = bpage->state();
-		if (status < buf_page_t::UNFIXED) {
-			ut_a(status >= buf_page_t::FREED);
-			continue;
-		}
-		const page_id_t id{bpage->id()};
+	/* Copy the page identifiers in chunks, releasing buf_pool.mutex
+	in between. A buffer-fix prevents the eviction of the page where
+	the copying resumes. If that page is moved in buf_pool.LRU
+	meanwhile, some pages may be skipped or copied twice. */
+	mysql_mutex_lock(&buf_pool.mutex);
 
-		if (id.space() == SRV_TMP_SPACE_ID) {
-			/* Ignore the innodb_temporary tablespace. */
-			continue;
+	for (bpage = UT_LIST_GET_FIRST(buf_pool.LRU); bpage && j < n_pages; ) {
+		for (ulint k = BUF_DUMP_CHUNK_PAGES; k && bpage && j < n_pages;
+		     k--, bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
+			const auto status = bpage->state();
+			if (status < buf_page_t::UNFIXED) {
+				ut_a(status >= buf_page_t::FREED);
+				continue;
+			}
+			const page_id_t id{bpage->id()};
+
+			if (id.space() == SRV_TMP_SPACE_ID) {
+				/* Ignore the innodb_temporary tablespace. */
+				continue;
+			}
+
+			dump[j++] = id;
 		}
 
-		dump[j++] = id;
+		if (bpage && j < n_pages) {
+			bpage->fix();
+			mysql_mutex_unlock(&buf_pool.mutex);
+			mysql_mutex_lock(&buf_pool.mutex);
+			bpage->unfix();
+		}
 	}
 
 	mysql_mutex_unlock(&buf_pool.mutex);
 
 	ut_a(j <= n_pages);
-	n_pages = j;
 
-	for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-		ret = fprintf(f, "%u,%u\n",
-			      dump[j].space(), dump[j].page_no());
-		if (ret < 0) {
-			ut_free(dump);
-			fclose(f);
-			buf_dump_status(STATUS_ERR,
-					"Cannot write to '%s': %s",
-					tmp_filename, strerror(errno));
-			/* leave tmp_filename to exist */
-			return;
+	/* The identifiers are delta-encoded in ascending order */
+	std::sort(dump, dump + j);
+	n_pages = ulint(std::unique(dump, dump + j) - dump);
+
+	{
+		byte	buf[4096];
+		byte*	b = buf;
+		page_id_t prev{0, 0};
+
+		memcpy(b, buf_dump_magic, sizeof buf_dump_magic);
+		b += sizeof buf_dump_magic;
+		mach_write_to_8(b, n_pages);
+		b += 8;
+
+		for (j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
+			const page_id_t id = dump[j];
+
+			if (id.space() != prev.space()) {
+				b = buf_dump_write_int(
+					b, uint64_t{id.space() - prev.space()}
+					<< 1 | 1);
+				b = buf_dump_write_int(b, id.page_no());
+			} else {
+				b = buf_dump_write_int(
+					b, uint64_t{id.page_no()
+						    - prev.page_no()} << 1);
+			}
+
+			prev = id;
+
+			if (b + 20 > buf + sizeof buf) {
+				if (fwrite(buf, ulint(b - buf), 1, f) != 1) {
+					goto write_error;
+				}
+				b = buf;
+			}
+
+			if (SHUTTING_DOWN() && !(j & 1023)) {
+				service_manager_extend_timeout(
+					INNODB_EXTEND_TIMEOUT_INTERVAL,
+					"Dumping buffer pool page "
+					ULINTPF "/" ULINTPF, j + 1, n_pages);
+			}
 		}
-		if (SHUTTING_DOWN() && !(j & 1023)) {
-			service_manager_extend_timeout(
-				INNODB_EXTEND_TIMEOUT_INTERVAL,
-				"Dumping buffer pool page "
-				ULINTPF "/" ULINTPF, j + 1, n_pages);
+
+		/* Write the header of an empty dump, or the rest of the
+		pages. If the dump was interrupted by shutdown,
+		buf_load_read_binary() will stop at the end of the file. */
+		if (b > buf && fwrite(buf, ulint(b - buf), 1, f) != 1) {
+			goto write_error;
 		}
 	}
 
 	ut_free(dump);
 
-done:
 	ret = IF_WIN(my_fclose(f,0),fclose(f));
 	if (ret != 0) {
 		buf_dump_status(STATUS_ERR,
@@ -413,6 +488,232 @@ buf_dump(
 	 we reset this to 0 here to indicate that a shutdown can also perform
 	 a dump */
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
+	return;
+
+write_error:
+	ut_free(dump);
+	fclose(f);
+	buf_dump_status(STATUS_ERR, "Cannot write to '%s': %s",
+			tmp_filename, strerror(errno));
+	/* leave tmp_filename to exist */
+}
+
+/** Read an integer of the binary dump format.
+@param f  dump file
+@param n  the integer
+@return whether an integer was read */
+static bool buf_load_read_int(FILE *f, uint64_t *n)
+{
+	*n = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+		int c = getc(f);
+		if (c == EOF) {
+			return false;
+		}
+		*n |= uint64_t(c & 0x7f) << shift;
+		if (!(c & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Read the page identifiers of a dump in the binary format.
+@param f       dump file, positioned after the number of pages
+@param n       number of pages in the dump
+@param dump    output array
+@param dump_n  size of dump
+@return number of page identifiers that were read
+@retval ULINT_UNDEFINED on error */
+static ulint buf_load_read_binary(FILE *f, uint64_t n, page_id_t *dump,
+				  ulint dump_n)
+{
+	uint64_t	space_id = 0, page_no = 0;
+	ulint		i = 0;
+
+	for (uint64_t j = 0; j < n && !SHUTTING_DOWN(); j++) {
+		uint64_t	delta;
+
+		if (!buf_load_read_int(f, &delta)) {
+			if (feof(f)) {
+				/* The dump was interrupted by shutdown */
+				break;
+			}
+			return ULINT_UNDEFINED;
+		}
+
+		if (delta & 1) {
+			space_id += delta >> 1;
+			if (!buf_load_read_int(f, &page_no)) {
+				return ULINT_UNDEFINED;
+			}
+		} else {
+			page_no += delta >> 1;
+		}
+
+		if (space_id > ULINT32_MASK || page_no > ULINT32_MASK) {
+			return ULINT_UNDEFINED;
+		}
+
+		/* If the dump is larger than the buffer pool, ignore the
+		rest of the pages but read on to the text lines. */
+		if (i < dump_n) {
+			dump[i++] = page_id_t(uint32_t(space_id),
+					      uint32_t(page_no));
+		}
+	}
+
+	return i;
+}
+
+/** Allocate memory for the page identifiers of a buffer pool load.
+@param n  number of pages
+@return the memory
+@retval nullptr if the allocation failed */
+static page_id_t *buf_load_alloc(ulint n)
+{
+	page_id_t*	dump = static_cast<page_id_t*>(
+		ut_malloc_nokey(n * sizeof *dump));
+
+	if (dump == NULL) {
+		std::ostringstream str_bytes;
+		str_bytes << ib::bytes_iec{n * sizeof *dump};
+		buf_dump_status(STATUS_ERR,
+				"Cannot allocate %s: %s",
+				str_bytes.str().c_str(),
+				strerror(errno));
+	}
+
+	return dump;
+}
+
+/** Pages that a buffer pool load task reads */
+struct buf_load_slice
+{
+	/** the first page */
+	const page_id_t*	begin;
+	/** end of the pages */
+	const page_id_t*	end;
+	/** whether all the pages were processed */
+	bool			completed;
+};
+
+/** Number of pages that the buffer pool load tasks have processed */
+static Atomic_counter<ulint>	buf_load_n_done;
+
+/** Read pages of a buffer pool load into the buffer pool. Runs of
+consecutive pages are read with one request.
+@param arg  buf_load_slice */
+static void buf_load_pages(void *arg)
+{
+	buf_load_slice*		slice = static_cast<buf_load_slice*>(arg);
+	/* If this allocation fails, the pages are read one by one. */
+	byte*			buf = static_cast<byte*>(
+		aligned_malloc(BUF_READ_MERGE_PAGES << srv_page_size_shift,
+			       srv_page_size));
+	uint32_t		cur_space_id = SRV_SPACE_ID_UPPER_BOUND;
+	fil_space_t*		space = nullptr;
+	ulint			zip_size = 0;
+	bool			merge = false;
+
+	const page_id_t*	p = slice->begin;
+
+	while (p < slice->end) {
+		if (SHUTTING_DOWN() || buf_load_abort_flag) {
+			break;
+		}
+
+		/* space_id for this iteration of the loop */
+		const uint32_t this_space_id = p->space();
+
+		if (this_space_id != cur_space_id) {
+			if (space) {
+				space->release();
+			}
+
+			cur_space_id = this_space_id;
+			space = this_space_id < SRV_SPACE_ID_UPPER_BOUND
+				? fil_space_t::get(this_space_id) : nullptr;
+
+			/* JAN: TODO: As we use background page read below,
+			if tablespace is encrypted we cant use it. */
+			if (space && space->crypt_data
+			    && space->crypt_data->encryption
+			    != FIL_ENCRYPTION_OFF
+			    && space->crypt_data->type
+			    != CRYPT_SCHEME_UNENCRYPTED) {
+				space->release();
+				space = nullptr;
+			}
+
+			if (space) {
+				zip_size = space->zip_size();
+				/* The system tablespace contains the
+				change buffer and the doublewrite buffer,
+				and a read cannot span several files */
+				merge = buf && this_space_id != TRX_SYS_SPACE
+					&& UT_LIST_GET_LEN(space->chain) == 1;
+			}
+		}
+
+		if (space && space->is_stopping()) {
+			space->release();
+			space = nullptr;
+		}
+
+		if (!space || p->page_no() >= space->get_size()) {
+			p++;
+			buf_load_n_done++;
+			continue;
+		}
+
+		const uint32_t	size = space->get_size();
+
+		ulint	max_run = BUF_READ_MERGE_PAGES;
+#ifdef UNIV_DEBUG
+		if (buf_load_n_done < srv_buf_pool_load_pages_abort) {
+			max_run = std::min<ulint>(
+				max_run,
+				srv_buf_pool_load_pages_abort
+				- buf_load_n_done);
+		}
+#endif
+
+		const page_id_t*	r = p + 1;
+
+		if (merge && !ibuf_bitmap_page(*p, zip_size)) {
+			while (r < slice->end && ulint(r - p) < max_run
+			       && *r == r[-1] + 1 && r->page_no() < size
+			       && !ibuf_bitmap_page(*r, zip_size)) {
+				r++;
+			}
+		}
+
+		space->reacquire();
+
+		if (r - p == 1) {
+			buf_read_page_background(space, *p, zip_size);
+		} else {
+			buf_read_pages_merged(space, *p, ulint(r - p),
+					      zip_size, buf);
+		}
+
+		buf_load_n_done += ulint(r - p);
+		p = r;
+
+#ifdef UNIV_DEBUG
+		if (buf_load_n_done >= srv_buf_pool_load_pages_abort) {
+			buf_load_abort_flag = true;
+		}
+#endif
+	}
+
+	if (space) {
+		space->release();
+	}
+
+	aligned_free(buf);
+	slice->completed = p == slice->end;
 }
 
 /*****************************************************************//**
@@ -429,12 +730,15 @@ buf_load()
 	char		full_filename[OS_FILE_MAX_PATH];
 	char		now[32];
 	FILE*		f;
-	page_id_t*	dump;
+	page_id_t*	dump = nullptr;
 	ulint		dump_n;
+	ulint		bin_n = 0;
 	ulint		i;
 	uint32_t	space_id;
 	uint32_t	page_no;
 	int		fscanf_ret;
+	long		text_start = 0;
+	byte		magic[sizeof buf_dump_magic];
 
 	/* Ignore any leftovers from before */
 	buf_load_abort_flag = false;
@@ -453,8 +757,42 @@ buf_load()
 	}
 	/* else */
 
-	/* First scan the file to estimate how many entries are in it.
-	This file is tiny (approx 500KB per 1GB buffer pool), reading it
+	/* If dump is larger than the buffer pool(s), then we ignore the
+	extra trailing. This could happen if a dump is made, then buffer
+	pool is shrunk and then load is attempted. */
+	const ulint	max_n = buf_pool.get_n_pages();
+
+	if (fread(magic, sizeof magic, 1, f) == 1
+	    && !memcmp(magic, buf_dump_magic, sizeof magic)) {
+		byte	b[8];
+		uint64_t n = fread(b, sizeof b, 1, f) == 1
+			? mach_read_from_8(b) : 0;
+
+		bin_n = ulint(std::min<uint64_t>(n, max_n));
+
+		if (bin_n && !(dump = buf_load_alloc(bin_n))) {
+			fclose(f);
+			return;
+		}
+
+		bin_n = buf_load_read_binary(f, n, dump, bin_n);
+
+		if (bin_n == ULINT_UNDEFINED) {
+			ut_free(dump);
+			fclose(f);
+			buf_load_status(STATUS_ERR, "Error parsing '%s',"
+					" unable to load buffer pool (stage 1)",
+					full_filename);
+			return;
+		}
+
+		text_start = ftell(f);
+	} else {
+		rewind(f);
+	}
+
+	/* Scan the rest of the file to estimate how many entries are in
+	it. This file is tiny (approx 500KB per 1GB buffer pool), reading it
 	two times is fine. */
 	dump_n = 0;
 	while (fscanf(f, "%u,%u", &space_id, &page_no) == 2
@@ -470,6 +808,7 @@ buf_load()
 		} else {
 			what = "parsing";
 		}
+		ut_free(dump);
 		fclose(f);
 		buf_load_status(STATUS_ERR, "Error %s '%s',"
 				" unable to load buffer pool (stage 1)",
@@ -477,15 +816,10 @@ buf_load()
 		return;
 	}
 
-	/* If dump is larger than the buffer pool(s), then we ignore the
-	extra trailing. This could happen if a dump is made, then buffer
-	pool is shrunk and then load is attempted. */
-	dump_n = std::min(dump_n, buf_pool.get_n_pages());
+	dump_n = std::min(bin_n + dump_n, max_n);
 
-	if (dump_n != 0) {
-		dump = static_cast<page_id_t*>(ut_malloc_nokey(
-				dump_n * sizeof(*dump)));
-	} else {
+	if (dump_n == 0) {
+		ut_free(dump);
 		fclose(f);
 		ut_sprintf_timestamp(now);
 		buf_load_status(STATUS_INFO,
@@ -494,23 +828,28 @@ buf_load()
 		return;
 	}
 
-	if (dump == NULL) {
-		std::ostringstream str_bytes;
-		fclose(f);
-		str_bytes << ib::bytes_iec{dump_n * sizeof(*dump)};
-		buf_dump_status(STATUS_ERR,
-				"Cannot allocate %s: %s",
-				str_bytes.str().c_str(),
-				strerror(errno));
-		/* leave tmp_filename to exist */
-		return;
+	if (dump_n > bin_n) {
+		/* Make room for the pages in the text format */
+		page_id_t*	text_dump = buf_load_alloc(dump_n);
+
+		if (text_dump == NULL) {
+			ut_free(dump);
+			fclose(f);
+			return;
+		}
+
+		if (bin_n) {
+			memcpy(text_dump, dump, bin_n * sizeof *dump);
+		}
+		ut_free(dump);
+		dump = text_dump;
 	}
 
-	rewind(f);
+	fseek(f, text_start, SEEK_SET);
 
 	export_vars.innodb_buffer_pool_load_incomplete = 1;
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
+	for (i = bin_n; i < dump_n && !SHUTTING_DOWN(); i++) {
 		fscanf_ret = fscanf(f, "%u,%u", &space_id, &page_no);
 
 		if (fscanf_ret != 2) {
@@ -537,7 +876,7 @@ buf_load()
 					", unable to load buffer pool",
 					full_filename,
 					space_id, page_no,
-					i);
+					i - bin_n);
 			return;
 		}
 
@@ -560,112 +899,80 @@ buf_load()
 		return;
 	}
 
+	/* Read the pages in the order of their file offsets, so that
+	adjacent pages can be read with one request. */
 	if (!SHUTTING_DOWN()) {
 		std::sort(dump, dump + dump_n);
 	}
 
-	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	uint32_t	cur_space_id = dump[0].space();
-	fil_space_t*	space = fil_space_t::get(cur_space_id);
-	ulint		zip_size = space ? space->zip_size() : 0;
-
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
 	mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
 	mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-
-		/* space_id for this iteration of the loop */
-		const uint32_t this_space_id = dump[i].space();
-
-		if (this_space_id >= SRV_SPACE_ID_UPPER_BOUND) {
-			continue;
-		}
-
-		if (this_space_id != cur_space_id) {
-			if (space) {
-				space->release();
-			}
-
-			cur_space_id = this_space_id;
-			space = fil_space_t::get(cur_space_id);
-
-			if (!space) {
-				continue;
-			}
-
-			zip_size = space->zip_size();
+	/* Read the pages in innodb_read_io_threads parallel tasks, one of
+	them being this one. Each task reads a contiguous part of dump[]. */
+	ulint n_tasks = std::max<ulint>(1, std::min<ulint>(
+		srv_n_read_io_threads,
+		dump_n / (BUF_READ_MERGE_PAGES * 4)));
+	std::vector<buf_load_slice>		slices(n_tasks);
+	std::vector<tpool::waitable_task*>	tasks;
+
+	buf_load_n_done = 0;
+
+	for (i = 0; i < n_tasks; i++) {
+		slices[i].begin = dump + dump_n * i / n_tasks;
+		slices[i].end = dump + dump_n * (i + 1) / n_tasks;
+		slices[i].completed = false;
+		if (i) {
+			tasks.push_back(new tpool::waitable_task(
+						buf_load_pages, &slices[i]));
+			srv_thread_pool->submit_task(tasks.back());
 		}
+	}
 
-		/* JAN: TODO: As we use background page read below,
-		if tablespace is encrypted we cant use it. */
-		if (!space || dump[i].page_no() >= space->get_size() ||
-		    (space->crypt_data &&
-		     space->crypt_data->encryption != FIL_ENCRYPTION_OFF &&
-		     space->crypt_data->type != CRYPT_SCHEME_UNENCRYPTED)) {
-			continue;
-		}
+	buf_load_pages(&slices[0]);
 
-		if (space->is_stopping()) {
-			space->release();
-			space = nullptr;
-			continue;
-		}
+	for (tpool::waitable_task* task : tasks) {
+		task->wait();
+		delete task;
+	}
 
-		space->reacquire();
-		buf_read_page_background(space, dump[i], zip_size);
+	ut_free(dump);
 
-		if (buf_load_abort_flag) {
-			if (space) {
-				space->release();
-			}
-			buf_load_abort_flag = false;
-			ut_free(dump);
-			buf_load_status(
-				STATUS_INFO,
-				"Buffer pool(s) load aborted on request");
-			/* Premature end, set estimated = completed = i and
-			end the current stage event. */
+	bool	completed = true;
 
-			mysql_stage_set_work_estimated(pfs_stage_progress, i);
-			mysql_stage_set_work_completed(pfs_stage_progress, i);
+	for (const buf_load_slice& slice : slices) {
+		completed &= slice.completed;
+	}
 
-			mysql_end_stage();
-			return;
-		}
+	if (buf_load_abort_flag) {
+		buf_load_abort_flag = false;
+		buf_load_status(
+			STATUS_INFO,
+			"Buffer pool(s) load aborted on request");
+		/* Premature end, set estimated = completed = the number
+		of processed pages and end the current stage event. */
 
-#ifdef UNIV_DEBUG
-		if ((i+1) >= srv_buf_pool_load_pages_abort) {
-			buf_load_abort_flag = true;
-		}
-#endif
-	}
+		mysql_stage_set_work_estimated(pfs_stage_progress,
+					       buf_load_n_done);
+		mysql_stage_set_work_completed(pfs_stage_progress,
+					       buf_load_n_done);
 
-	if (space) {
-		space->release();
+		mysql_end_stage();
+		return;
 	}
 
-	ut_free(dump);
-
-	if (i == dump_n) {
+	if (completed) {
 		os_aio_wait_until_no_pending_reads();
 	}
 
 	ut_sprintf_timestamp(now);
 
-	if (i == dump_n) {
+	if (completed) {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load completed at %s", now);
 		export_vars.innodb_buffer_pool_load_incomplete = 0;
-	} else if (!buf_load_abort_flag) {
-		buf_load_status(STATUS_INFO,
-			"Buffer pool(s) load aborted due to user instigated abort at %s",
-			now);
-		/* intentionally don't reset innodb_buffer_pool_load_incomplete
-                   as we don't want a shutdown to save the buffer pool */
 	} else {
 		buf_load_status(STATUS_INFO,
 			"Buffer pool(s) load aborted due to shutdown at %s",
@@ -686,6 +993,28 @@ void buf_load_abort()
   buf_load_abort_flag= true;
 }
 
+/** Start a buffer pool dump if innodb_buffer_pool_dump_interval has
+passed since the previous one.
+@param counter_time  microsecond_interval_timer() */
+void buf_dump_at_interval(ulonglong counter_time)
+{
+  static ulonglong last_dump;
+  const ulonglong interval= srv_buf_pool_dump_interval * 1000000ULL;
+
+  if (!interval)
+    last_dump= 0;
+  else if (!last_dump)
+    last_dump= counter_time;
+  else if (counter_time - last_dump >= interval)
+  {
+    last_dump= counter_time;
+    /* Do not replace the dump while it is being loaded, or after a
+    load was aborted, as at shutdown */
+    if (!export_vars.innodb_buffer_pool_load_incomplete)
+      buf_dump_start();
+  }
+}
+
 /*****************************************************************//**
 This is the main task for buffer pool dump/load. when scheduled
 either performs a dump or load, depending on server state, state of the variables etc- */
@@ -1312,6 +1312,89 @@ static ulint buf_do_LRU_batch(ulint max)
   return n.flushed;
 }
 
+/** Maximum number of pages of a flush list batch that are sorted by
+page identifier before the writes are submitted */
+static constexpr ulint BUF_FLUSH_SORT_PAGES= 128;
+
+/** Write out pages that were collected from the end of the flush_list,
+in the order of their page identifiers. Adjacent pages will then be
+submitted consecutively, both to the doublewrite buffer and to the
+data files, so that the writes of a batch are mostly sequential.
+@param ids            page_id_t::raw() of dirty pages (will be sorted)
+@param n              number of elements in ids
+@param neighbors      innodb_flush_neighbors, or 0
+@param space          the tablespace that was looked up last
+@param last_space_id  the identifier of the tablespace looked up last
+@param count          number of pages flushed so far in this batch
+@param max_n          maximum number of pages to flush in this batch
+@return number of pages for which the write request was queued */
+static ulint buf_flush_sorted(uint64_t *ids, ulint n, ulong neighbors,
+                              fil_space_t *&space, uint32_t &last_space_id,
+                              ulint count, ulint max_n)
+{
+  mysql_mutex_assert_owner(&buf_pool.mutex);
+  mysql_mutex_assert_not_owner(&buf_pool.flush_list_mutex);
+
+  std::sort(ids, ids + n);
+
+  ulint flushed= 0;
+
+  for (const uint64_t *i= ids; i < ids + n && count + flushed < max_n; i++)
+  {
+    const page_id_t id{*i};
+    const uint32_t space_id= id.space();
+    if (!space || space->id != space_id)
+    {
+      if (last_space_id != space_id)
+      {
+        mysql_mutex_unlock(&buf_pool.mutex);
+        if (space)
+          space->release();
+        auto p= buf_flush_space(space_id);
+        space= p.first;
+        last_space_id= space_id;
+        mysql_mutex_lock(&buf_pool.mutex);
+        if (p.second)
+          buf_pool.stat.n_pages_written+= p.second;
+      }
+      else
+        ut_ad(!space);
+    }
+    else if (space->is_stopping())
+    {
+      space->release();
+      space= nullptr;
+    }
+
+    if (space && neighbors && space->is_rotational())
+    {
+      mysql_mutex_unlock(&buf_pool.mutex);
+      flushed+= buf_flush_try_neighbors(space, id, neighbors == 1, false,
+                                        count + flushed, max_n);
+      mysql_mutex_lock(&buf_pool.mutex);
+      continue;
+    }
+
+    /* The page may have been written or evicted meanwhile, for example
+    as a neighbor of an earlier page. */
+    buf_page_t *bpage=
+      buf_pool.page_hash.get(id, buf_pool.page_hash.cell_get(id.fold()));
+    if (!bpage || buf_pool.watch_is_sentinel(*bpage) ||
+        bpage->oldest_modification() <= 1 || !bpage->ready_for_flush())
+      continue;
+
+    if (!space)
+      buf_flush_discard_page(bpage);
+    else if (bpage->flush(false, space))
+    {
+      ++flushed;
+      mysql_mutex_lock(&buf_pool.mutex);
+    }
+  }
+
+  return flushed;
+}
+
 /** This utility flushes dirty blocks from the end of the flush_list.
 The calling thread is not allowed to own any latches on pages!
 @param max_n    maximum mumber of blocks to flush
@@ -1331,6 +1414,10 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn)
   static_assert(FIL_NULL > SRV_TMP_SPACE_ID, "consistency");
   static_assert(FIL_NULL > SRV_SPACE_ID_UPPER_BOUND, "consistency");
 
+  /* Identifiers of the pages that will be written next */
+  uint64_t ids[BUF_FLUSH_SORT_PAGES];
+  ulint n= 0;
+
   /* Start from the end of the list looking for a suitable block to be
   flushed. */
   mysql_mutex_lock(&buf_pool.flush_list_mutex);
@@ -1347,17 +1434,18 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn)
     buf_page_t *prev= UT_LIST_GET_PREV(list, bpage);
 
     if (oldest_modification == 1)
-    {
       buf_pool.delete_from_flush_list(bpage);
-    skip:
-      bpage= prev;
-      continue;
+    else
+    {
+      ut_ad(oldest_modification > 2);
+      if (bpage->ready_for_flush())
+        ids[n++]= bpage->id().raw();
     }
 
-    ut_ad(oldest_modification > 2);
+    bpage= prev;
 
-    if (!bpage->ready_for_flush())
-      goto skip;
+    if (n < std::min(BUF_FLUSH_SORT_PAGES, max_n - count))
+      continue;
 
     /* In order not to degenerate this scan to O(n*n) we attempt to
     preserve the pointer position. Any thread that would remove 'prev'
@@ -1370,69 +1458,20 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn)
     but buf_flush_list_space() is ignoring that. */
     buf_pool.flush_hp.set(prev);
     mysql_mutex_unlock(&buf_pool.flush_list_mutex);
-
-    const page_id_t page_id(bpage->id());
-    const uint32_t space_id= page_id.space();
-    if (!space || space->id != space_id)
-    {
-      if (last_space_id != space_id)
-      {
-        mysql_mutex_lock(&buf_pool.flush_list_mutex);
-        buf_pool.flush_hp.set(bpage);
-        mysql_mutex_unlock(&buf_pool.flush_list_mutex);
-        mysql_mutex_unlock(&buf_pool.mutex);
-        if (space)
-          space->release();
-        auto p= buf_flush_space(space_id);
-        space= p.first;
-        last_space_id= space_id;
-        mysql_mutex_lock(&buf_pool.mutex);
-        if (p.second)
-          buf_pool.stat.n_pages_written+= p.second;
-        mysql_mutex_lock(&buf_pool.flush_list_mutex);
-        bpage= buf_pool.flush_hp.get();
-        if (!bpage)
-          break;
-        if (bpage->id() != page_id)
-          continue;
-        buf_pool.flush_hp.set(UT_LIST_GET_PREV(list, bpage));
-        if (bpage->oldest_modification() <= 1 || !bpage->ready_for_flush())
-          goto next;
-        mysql_mutex_unlock(&buf_pool.flush_list_mutex);
-      }
-      else
-        ut_ad(!space);
-    }
-    else if (space->is_stopping())
-    {
-      space->release();
-      space= nullptr;
-    }
-
-    if (!space)
-      buf_flush_discard_page(bpage);
-    else if (neighbors && space->is_rotational())
-    {
-      mysql_mutex_unlock(&buf_pool.mutex);
-      count+= buf_flush_try_neighbors(space, page_id, neighbors == 1,
-                                      false, count, max_n);
-    reacquire_mutex:
-      mysql_mutex_lock(&buf_pool.mutex);
-    }
-    else if (bpage->flush(false, space))
-    {
-      ++count;
-      goto reacquire_mutex;
-    }
-
+    count+= buf_flush_sorted(ids, n, neighbors, space, last_space_id,
+                             count, max_n);
+    n= 0;
     mysql_mutex_lock(&buf_pool.flush_list_mutex);
-  next:
     bpage= buf_pool.flush_hp.get();
   }
 
   buf_pool.flush_hp.set(nullptr);
   mysql_mutex_unlock(&buf_pool.flush_list_mutex);
 
+  if (n)
+    count+= buf_flush_sorted(ids, n, neighbors, space, last_space_id,
+                             count, max_n);
+
   if (space)
     space->release();
 
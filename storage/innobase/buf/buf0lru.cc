@@ -267,6 +267,35 @@ static bool buf_LRU_free_from_common_LRU_list(ulint limit)
 	return(freed);
 }
 
+#ifdef HAVE_LIBNUMA
+/** Maximum number of buf_pool.free elements to look at in order to find
+a block on the NUMA node of the current thread */
+static constexpr ulint BUF_LRU_NUMA_SCAN = 64;
+#endif /* HAVE_LIBNUMA */
+
+/** @return the first block of buf_pool.free, or with innodb_numa_local,
+a block whose page frame is on the NUMA node of the current thread */
+static buf_block_t* buf_LRU_free_first()
+{
+	buf_page_t*	bpage = UT_LIST_GET_FIRST(buf_pool.free);
+
+#ifdef HAVE_LIBNUMA
+	if (bpage && buf_pool.numa_n_nodes) {
+		const ulint	node = buf_pool.numa_local_node();
+		ulint		n = BUF_LRU_NUMA_SCAN;
+
+		for (buf_page_t* b = bpage; b && n--;
+		     b = UT_LIST_GET_NEXT(list, b)) {
+			if (buf_pool.numa_node_of(b->frame) == node) {
+				return reinterpret_cast<buf_block_t*>(b);
+			}
+		}
+	}
+#endif /* HAVE_LIBNUMA */
+
+	return reinterpret_cast<buf_block_t*>(bpage);
+}
+
 /** @return a buffer block from the buf_pool.free list
 @retval	NULL	if the free list is empty */
 buf_block_t* buf_LRU_get_free_only()
@@ -275,8 +304,7 @@ buf_block_t* buf_LRU_get_free_only()
 
 	mysql_mutex_assert_owner(&buf_pool.mutex);
 
-	block = reinterpret_cast<buf_block_t*>(
-		UT_LIST_GET_FIRST(buf_pool.free));
+	block = buf_LRU_free_first();
 
 	while (block != NULL) {
 		ut_ad(block->page.in_free_list);
@@ -303,8 +331,7 @@ buf_block_t* buf_LRU_get_free_only()
 		UT_LIST_ADD_LAST(buf_pool.withdraw, &block->page);
 		ut_d(block->in_withdraw_list = true);
 
-		block = reinterpret_cast<buf_block_t*>(
-			UT_LIST_GET_FIRST(buf_pool.free));
+		block = buf_LRU_free_first();
 	}
 
 	return(block);
@@ -487,6 +487,82 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
 	ignore these in our heuristics. */
 }
 
+/** Read consecutive pages of a tablespace that are not in the buffer pool
+with one synchronous read request.
+@param space     tablespace; will be released
+@param page_id   the first page
+@param n         number of pages, at most BUF_READ_MERGE_PAGES
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@param buf       buffer for n pages of the physical page size
+@return number of pages that were read */
+ulint buf_read_pages_merged(fil_space_t *space, const page_id_t page_id,
+                            ulint n, ulint zip_size, byte *buf)
+{
+  ut_ad(n <= BUF_READ_MERGE_PAGES);
+  ut_ad(space->id != TRX_SYS_SPACE);
+  ut_ad(UT_LIST_GET_LEN(space->chain) == 1);
+
+  buf_page_t *bpages[BUF_READ_MERGE_PAGES];
+  ulint first= n, last= 0;
+
+  for (ulint i= 0; i < n; i++)
+  {
+    ut_ad(!ibuf_bitmap_page(page_id + uint32_t(i), zip_size));
+    bpages[i]= buf_page_init_for_read(BUF_READ_ANY_PAGE,
+                                      page_id + uint32_t(i), zip_size, false);
+    if (bpages[i])
+    {
+      first= std::min(first, i);
+      last= i;
+    }
+  }
+
+  if (first == n)
+  {
+    space->release();
+    return 0;
+  }
+
+  /* Read the pages from the first to the last one that were not in the
+  buffer pool, including any that were */
+  const ulint len= zip_size ? zip_size : srv_page_size;
+  auto fio= space->io(IORequest(IORequest::READ_SYNC),
+                      os_offset_t{page_id.page_no() + first} * len,
+                      (last - first + 1) * len, buf);
+
+  ulint count= 0;
+  for (ulint i= first; i <= last; i++)
+  {
+    buf_page_t *bpage= bpages[i];
+    if (!bpage);
+    else if (UNIV_UNLIKELY(fio.err != DB_SUCCESS))
+    {
+      ut_d(auto n=) buf_pool.n_pend_reads--;
+      ut_ad(n > 0);
+      buf_pool.corrupted_evict(bpage, buf_page_t::READ_FIX);
+    }
+    else
+    {
+      memcpy_aligned<UNIV_ZIP_SIZE_MIN>(zip_size
+                                        ? bpage->zip.data : bpage->frame,
+                                        buf + (i - first) * len, len);
+      bpage->read_complete(*fio.node);
+      count++;
+    }
+  }
+
+  if (fio.err == DB_SUCCESS)
+  {
+    DBUG_PRINT("ib_buf", ("merged read of %zu pages from %s: %u",
+                          count, space->chain.start->name,
+                          page_id.page_no()));
+    space->release();
+  }
+
+  srv_stats.buf_pool_reads.add(count);
+  return count;
+}
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
@@ -655,6 +731,59 @@ buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf)
   return count;
 }
 
+/** Read ahead the leaf pages that a scan of an index is predicted to
+access next (innodb_read_ahead_pages).
+@param space     tablespace
+@param page_no   the first page to read
+@param stride    difference of the page numbers of consecutive pages
+@param n         number of pages to read
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of page read requests issued */
+ulint buf_read_ahead_pages(fil_space_t *space, uint32_t page_no,
+                           int32_t stride, ulint n, ulint zip_size)
+{
+  ut_ad(stride);
+
+  if (srv_startup_is_before_trx_rollback_phase)
+    /* No read-ahead to avoid thread deadlocks */
+    return 0;
+
+  if (buf_pool.n_pend_reads > buf_pool.curr_size / BUF_READ_AHEAD_PEND_LIMIT)
+    return 0;
+
+  if (!space->acquire())
+    return 0;
+
+  const int64_t last= space->last_page_number();
+  ulint count= 0;
+
+  for (int64_t i= page_no; n-- && i > 0 && i <= last; i+= stride)
+  {
+    const page_id_t id{space->id, uint32_t(i)};
+    if (ibuf_bitmap_page(id, zip_size) || trx_sys_hdr_page(id))
+      continue;
+    if (space->is_stopping())
+      break;
+    dberr_t err;
+    space->reacquire();
+    count+= buf_read_page_low(&err, space, false, BUF_READ_ANY_PAGE, id,
+                              zip_size, false);
+  }
+
+  if (count)
+  {
+    DBUG_PRINT("ib_buf", ("leaf read-ahead %zu pages from %s: %u",
+                          count, space->chain.start->name, page_no));
+    /* Read ahead is considered one I/O operation for the purpose of
+    LRU policy decision. */
+    buf_LRU_stat_inc_io();
+  }
+  space->release();
+
+  buf_pool.stat.n_ra_pages_read+= count;
+  return count;
+}
+
 /** @return whether a page has been freed */
 inline bool fil_space_t::is_freed(uint32_t page)
 {
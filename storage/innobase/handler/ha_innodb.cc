@@ -100,6 +100,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0mysql.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
+#include "row0pscan.h"
 #include "row0upd.h"
 #include "fil0crypt.h"
 #include "srv0mon.h"
@@ -887,6 +888,10 @@ static MYSQL_THDVAR_UINT(lock_wait_timeout, PLUGIN_VAR_RQCMDARG,
   "Timeout in seconds an InnoDB transaction may wait for a lock before being rolled back. The value 100000000 is infinite timeout.",
   NULL, NULL, 50, 0, 100000000, 0);
 
+static MYSQL_THDVAR_UINT(parallel_read_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads for a non-locking full scan of a table; 1 disables parallel scans",
+  NULL, NULL, 1, 1, 256, 0);
+
 static MYSQL_THDVAR_STR(ft_user_stopword_table,
   PLUGIN_VAR_OPCMDARG|PLUGIN_VAR_MEMALLOC,
   "User supplied stopword table name, effective in the session level.",
@@ -1001,6 +1006,7 @@ static SHOW_VAR innodb_status_variables[]= {
   {"pages_created", &buf_pool.stat.n_pages_created, SHOW_SIZE_T},
   {"pages_read", &buf_pool.stat.n_pages_read, SHOW_SIZE_T},
   {"pages_written", &buf_pool.stat.n_pages_written, SHOW_SIZE_T},
+  {"parallel_read_scans", &row_pscan_n_scans, SHOW_SIZE_T},
   {"row_lock_current_waits", &export_vars.innodb_row_lock_current_waits,
    SHOW_SIZE_T},
   {"row_lock_time", &export_vars.innodb_row_lock_time, SHOW_LONGLONG},
@@ -1046,10 +1052,16 @@ static SHOW_VAR innodb_status_variables[]= {
   /* Online alter table status variables */
   {"onlineddl_rowlog_rows",
    &export_vars.innodb_onlineddl_rowlog_rows, SHOW_SIZE_T},
+  {"onlineddl_rowlog_applied",
+   &export_vars.innodb_onlineddl_rowlog_applied, SHOW_SIZE_T},
   {"onlineddl_rowlog_pct_used",
    &export_vars.innodb_onlineddl_rowlog_pct_used, SHOW_SIZE_T},
   {"onlineddl_pct_progress",
    &export_vars.innodb_onlineddl_pct_progress, SHOW_SIZE_T},
+  {"onlineddl_sort_tasks",
+   &export_vars.innodb_onlineddl_sort_tasks, SHOW_SIZE_T},
+  {"onlineddl_rowlog_applied_in_sort",
+   &export_vars.innodb_onlineddl_rowlog_applied_in_sort, SHOW_SIZE_T},
 
   /* Encryption */
   {"encryption_rotation_pages_read_from_cache",
@@ -3011,7 +3023,8 @@ ha_innobase::ha_innobase(
 			  |  (srv_force_primary_key ? HA_REQUIRE_PRIMARY_KEY : 0)
 		  ),
 	m_start_of_scan(),
-        m_mysql_has_locked()
+        m_mysql_has_locked(),
+	m_pscan()
 {}
 
 /*********************************************************************//**
@@ -6271,6 +6284,7 @@ ha_innobase::close()
 {
 	DBUG_ENTER("ha_innobase::close");
 
+	pscan_end();
 	row_prebuilt_free(m_prebuilt);
 
 	if (m_upd_buf != NULL) {
@@ -7291,6 +7305,9 @@ ha_innobase::build_template(
 	ibool		fetch_all_in_key	= FALSE;
 	ibool		fetch_primary_key_cols	= FALSE;
 
+	/* A parallel scan would be reading the template. */
+	pscan_end();
+
 	if (m_prebuilt->select_lock_type == LOCK_X || m_prebuilt->table->no_rollback()) {
 		/* We always retrieve the whole clustered index record if we
 		use exclusive row level locks, for example, if the read is
@@ -9412,9 +9429,49 @@ int
 ha_innobase::rnd_end(void)
 /*======================*/
 {
+	pscan_end();
 	return(index_end());
 }
 
+/** Try to start a parallel scan of the clustered index
+(see innodb_parallel_read_threads).
+@return whether the parallel scan was started */
+bool ha_innobase::pscan_start()
+{
+	ut_ad(!m_pscan);
+
+	const ulint n_threads = THDVAR(m_user_thd, parallel_read_threads);
+
+	if (n_threads <= 1 || !m_prebuilt->table->is_readable()) {
+		return false;
+	}
+
+	if (m_prebuilt->sql_stat_start) {
+		build_template(false);
+	}
+
+	if (!row_pscan_t::is_supported(m_prebuilt)) {
+		return false;
+	}
+
+	m_pscan = new row_pscan_t(m_prebuilt, n_threads);
+
+	if (m_pscan->start() == DB_SUCCESS) {
+		return true;
+	}
+
+	/* Let row_search_mvcc() scan the table, or report the error. */
+	pscan_end();
+	return false;
+}
+
+/** Stop a parallel scan of the clustered index, if one was started */
+void ha_innobase::pscan_end()
+{
+	delete m_pscan;
+	m_pscan = nullptr;
+}
+
 /*****************************************************************//**
 Reads the next row in a table scan (also used to read the FIRST row
 in a table scan).
@@ -9430,7 +9487,7 @@ ha_innobase::rnd_next(
 
 	DBUG_ENTER("rnd_next");
 
-	if (m_start_of_scan) {
+	if (m_start_of_scan && !pscan_start()) {
 		error = index_first(buf);
 
 		if (error == HA_ERR_KEY_NOT_FOUND) {
@@ -9438,6 +9495,23 @@ ha_innobase::rnd_next(
 		}
 
 		m_start_of_scan = false;
+	} else if (m_pscan) {
+		m_start_of_scan = false;
+
+		switch (dberr_t ret = m_pscan->fetch(buf)) {
+		case DB_SUCCESS:
+			error = 0;
+			table->status = 0;
+			break;
+		case DB_END_OF_INDEX:
+			error = HA_ERR_END_OF_FILE;
+			table->status = STATUS_NOT_FOUND;
+			break;
+		default:
+			error = convert_error_code_to_mysql(
+				ret, m_prebuilt->table->flags, m_user_thd);
+			table->status = STATUS_NOT_FOUND;
+		}
 	} else {
 		error = general_fetch(buf, ROW_SEL_NEXT, 0);
 	}
@@ -15644,6 +15718,8 @@ MySQL calls this method at the end of each statement */
 int
 ha_innobase::reset()
 {
+	pscan_end();
+
 	if (m_prebuilt->blob_heap) {
 		row_mysql_prebuilt_free_blob_heap(m_prebuilt);
 	}
@@ -19017,6 +19093,13 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_dump_interval, srv_buf_pool_dump_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Dump the buffer pool in the background every this many seconds,"
+  " so that a recent dump can be loaded after a crash"
+  " (0=only at shutdown or on request)",
+  NULL, NULL, 0, 0, 86400, 0);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19210,6 +19293,12 @@ static MYSQL_SYSVAR_ULONG(sort_buffer_size, srv_sort_buf_size,
   "Memory buffer size for index creation",
   NULL, NULL, 1048576, 65536, 64<<20, 0);
 
+static MYSQL_SYSVAR_ULONG(sort_threads, srv_sort_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of threads that merge sort and load the non-unique indexes"
+  " of ALTER TABLE or CREATE INDEX in parallel",
+  NULL, NULL, 1, 1, innodb_sort_threads_MAX, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(online_alter_log_max_size, srv_online_max_size,
   PLUGIN_VAR_RQCMDARG,
   "Maximum modification log file size for online index creation",
@@ -19413,6 +19502,12 @@ static MYSQL_SYSVAR_BOOL(numa_interleave, srv_numa_interleave,
   PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
   "Use NUMA interleave memory policy to allocate InnoDB buffer pool.",
   NULL, NULL, FALSE);
+
+static MYSQL_SYSVAR_BOOL(numa_local, srv_numa_local,
+  PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+  "Place the InnoDB buffer pool pages on all NUMA nodes, and prefer"
+  " pages on the NUMA node of the thread when reading a page.",
+  NULL, NULL, FALSE);
 #endif /* HAVE_LIBNUMA */
 
 static MYSQL_SYSVAR_ENUM(change_buffering, innodb_change_buffering,
@@ -19466,6 +19561,12 @@ static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   " trigger a readahead.",
   NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(read_ahead_pages, srv_read_ahead_pages,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of leaf pages to read ahead when a cursor scans an index"
+  " forward, backward or with a fixed page number stride (0=disable).",
+  NULL, NULL, 8, 0, 256, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
   PLUGIN_VAR_RQCMDARG,
   "Turn on a monitor counter",
@@ -19675,6 +19776,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_dump_interval),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -19722,6 +19824,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(deadlock_detect),
   MYSQL_SYSVAR(deadlock_report),
   MYSQL_SYSVAR(page_size),
+  MYSQL_SYSVAR(parallel_read_threads),
   MYSQL_SYSVAR(log_buffer_size),
 #if defined __linux__ || defined _WIN32
   MYSQL_SYSVAR(log_file_buffering),
@@ -19762,6 +19865,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(status_file),
   MYSQL_SYSVAR(strict_mode),
   MYSQL_SYSVAR(sort_buffer_size),
+  MYSQL_SYSVAR(sort_threads),
   MYSQL_SYSVAR(online_alter_log_max_size),
   MYSQL_SYSVAR(sync_spin_loops),
   MYSQL_SYSVAR(spin_wait_delay),
@@ -19772,6 +19876,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(use_native_aio),
 #ifdef HAVE_LIBNUMA
   MYSQL_SYSVAR(numa_interleave),
+  MYSQL_SYSVAR(numa_local),
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(change_buffering),
   MYSQL_SYSVAR(change_buffer_max_size),
@@ -19781,6 +19886,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
+  MYSQL_SYSVAR(read_ahead_pages),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(read_only_compressed),
   MYSQL_SYSVAR(instant_alter_column_allowed),
@@ -35,6 +35,9 @@ struct row_prebuilt_t;
 /** InnoDB transaction */
 struct trx_t;
 
+/** Parallel scan of a clustered index */
+class row_pscan_t;
+
 /** Engine specific table options are defined using this struct */
 struct ha_table_option_struct
 {
@@ -487,6 +490,12 @@ class ha_innobase final : public handler
 	false if accessing individual fields is enough */
 	void build_template(bool whole_row);
 
+	/** Try to start a parallel scan of the clustered index.
+	@return whether the parallel scan was started */
+	bool pscan_start();
+	/** Stop a parallel scan of the clustered index, if any */
+	void pscan_end();
+
 	int info_low(uint, bool);
 
 	/** The multi range read session object */
@@ -521,6 +530,9 @@ class ha_innobase final : public handler
 
         /** If mysql has locked with external_lock() */
         bool                    m_mysql_has_locked;
+
+	/** parallel table scan that was started by rnd_next(), or nullptr */
+	row_pscan_t*		m_pscan;
 };
 
 
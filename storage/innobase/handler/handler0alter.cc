@@ -7750,6 +7750,9 @@ ha_innobase::prepare_inplace_alter_table(
 
 	/* Init online ddl status variables */
 	onlineddl_rowlog_rows = 0;
+	onlineddl_rowlog_applied = 0;
+	onlineddl_rowlog_applied_in_sort = 0;
+	onlineddl_sort_tasks = 0;
 	onlineddl_rowlog_pct_used = 0;
 	onlineddl_pct_progress = 0;
 
@@ -366,6 +366,18 @@ struct btr_pcur_t
   byte *old_rec_buf= nullptr;
   /** old_rec_buf size if old_rec_buf is not NULL */
   ulint buf_size= 0;
+  /** the leaf page that the cursor last moved to from a sibling page
+  (innodb_read_ahead_pages) */
+  uint32_t ra_last= FIL_NULL;
+  /** the last page of the current read-ahead pattern that was read
+  ahead, or FIL_NULL */
+  uint32_t ra_horizon= FIL_NULL;
+  /** difference of the page numbers in the last move to a sibling page */
+  int32_t ra_stride= 0;
+  /** number of consecutive moves to a sibling page */
+  uint16_t ra_moves= 0;
+  /** number of consecutive moves with the difference ra_stride */
+  uint16_t ra_streak= 0;
 
   /** Return the index of this persistent cursor */
   dict_index_t *index() const { return(btr_cur.index()); }
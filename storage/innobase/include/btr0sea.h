@@ -36,6 +36,58 @@ Created 2/17/1996 Heikki Tuuri
 extern mysql_pfs_key_t btr_search_latch_key;
 #endif /* UNIV_PFS_RWLOCK */
 
+/** Latch of an adaptive hash index partition. In addition to the
+srw_spin_lock, it maintains a sequence number that is odd while the
+latch is held exclusively. This allows btr_search_guess_on_hash() to
+look up the hash table without acquiring the latch, and to detect
+whether the partition was modified during the lookup. */
+class btr_search_latch
+{
+  /** the latch */
+  srw_spin_lock lock;
+  /** sequence number; incremented on wr_lock() and wr_unlock() */
+  std::atomic<uint32_t> seq;
+public:
+  void init() { lock.SRW_LOCK_INIT(btr_search_latch_key); }
+  void destroy() { lock.destroy(); }
+
+  void rd_lock(SRW_LOCK_ARGS(const char *file, unsigned line))
+  { lock.rd_lock(SRW_LOCK_ARGS(file, line)); }
+  void rd_unlock() { lock.rd_unlock(); }
+
+  void wr_lock(SRW_LOCK_ARGS(const char *file, unsigned line))
+  {
+    lock.wr_lock(SRW_LOCK_ARGS(file, line));
+    seq.store(seq.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+    /* The odd sequence number must be visible before any change to
+    the hash table. */
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  void wr_unlock()
+  {
+    seq.store(seq.load(std::memory_order_relaxed) + 1,
+              std::memory_order_release);
+    lock.wr_unlock();
+  }
+
+  bool is_locked() const { return lock.is_locked(); }
+
+  /** Start a lookup without holding the latch.
+  @return the sequence number for read_validate()
+  @retval odd if the partition is being modified */
+  uint32_t read_begin() const { return seq.load(std::memory_order_seq_cst); }
+
+  /** Check whether a lookup without the latch was consistent.
+  @param s  return value of read_begin()
+  @return whether the partition was not modified since read_begin() */
+  bool read_validate(uint32_t s) const
+  {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq.load(std::memory_order_relaxed) == s;
+  }
+};
+
 #define btr_search_sys_create() btr_search_sys.create()
 #define btr_search_sys_free() btr_search_sys.free()
 
@@ -110,7 +162,7 @@ void btr_search_drop_page_hash_when_freed(const page_id_t page_id);
 			inserted next to the cursor.
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
-                                           srw_spin_lock *ahi_latch);
+                                           btr_search_latch *ahi_latch);
 
 /** Updates the page hash index when a single record is inserted on a page.
 @param[in,out]	cursor		cursor which was positioned to the
@@ -119,7 +171,7 @@ void btr_search_update_hash_node_on_insert(btr_cur_t *cursor,
 				to the cursor
 @param[in]	ahi_latch	the adaptive hash index latch */
 void btr_search_update_hash_on_insert(btr_cur_t *cursor,
-                                      srw_spin_lock *ahi_latch);
+                                      btr_search_latch *ahi_latch);
 
 /** Updates the page hash index when a single record is deleted from a page.
 @param[in]	cursor	cursor which was positioned on the record to delete
@@ -240,11 +292,15 @@ struct btr_search_sys_t
   struct partition
   {
     /** latches protecting hash_table */
-    srw_spin_lock latch;
+    btr_search_latch latch;
     /** mapping of dtuple_fold() to rec_t* in buf_block_t::frame */
     hash_table_t table;
     /** memory heap for table */
     mem_heap_t *heap;
+    /** nodes that were removed from table. They are not returned to
+    heap, so that a lookup without the latch will only ever access
+    ha_node_t objects until clear() is invoked. */
+    ha_node_t *free_nodes;
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -253,7 +309,7 @@ struct btr_search_sys_t
 #endif
 
     char pad[(CPU_LEVEL1_DCACHE_LINESIZE - sizeof latch -
-              sizeof table - sizeof heap) &
+              sizeof table - sizeof heap - sizeof free_nodes) &
              (CPU_LEVEL1_DCACHE_LINESIZE - 1)];
 
 #ifdef _MSC_VER
@@ -263,7 +319,7 @@ struct btr_search_sys_t
     void init()
     {
       memset((void*) this, 0, sizeof *this);
-      latch.SRW_LOCK_INIT(btr_search_latch_key);
+      latch.init();
     }
 
     void alloc(ulint hash_size)
@@ -280,6 +336,7 @@ struct btr_search_sys_t
     {
       mem_heap_free(heap);
       heap= nullptr;
+      free_nodes= nullptr;
       ut_free(table.array);
     }
 
@@ -294,6 +351,28 @@ struct btr_search_sys_t
   /** Partitions of the adaptive hash index */
   partition *parts;
 
+  /** Number of threads in btr_search_guess_on_hash() that may be
+  accessing the hash tables without holding a partition latch. The
+  count is spread over cache lines that are chosen by the thread, so
+  that such lookups do not write to memory that is shared between
+  threads. */
+  struct alignas(CPU_LEVEL1_DCACHE_LINESIZE) reader_slot
+  {
+    std::atomic<uint32_t> n;
+  };
+  /** Number of reader_slot */
+  static constexpr ulint N_READER_SLOTS= 64;
+  /** Counts of lookups without a partition latch */
+  reader_slot readers[N_READER_SLOTS];
+
+  /** @return the count of lookups of the current thread */
+  std::atomic<uint32_t> &reader();
+
+  /** Wait for all lookups that do not hold a partition latch to
+  complete. The caller must hold all partition latches exclusively,
+  so that no new such lookup can succeed. */
+  void wait_for_readers() const;
+
   /** Get an adaptive hash index partition */
   partition *get_part(index_id_t id, ulint space_id) const
   {
@@ -309,7 +388,7 @@ struct btr_search_sys_t
   }
 
   /** Get the search latch for the adaptive hash index partition */
-  srw_spin_lock *get_latch(const dict_index_t &index) const
+  btr_search_latch *get_latch(const dict_index_t &index) const
   { return &get_part(index)->latch; }
 
   /** Create and initialize at startup */
@@ -354,7 +433,7 @@ TRANSACTIONAL_INLINE inline ulint dict_index_t::n_ahi_pages() const
 {
   if (!btr_search_enabled)
     return 0;
-  srw_spin_lock *latch= &btr_search_sys.get_part(*this)->latch;
+  btr_search_latch *latch= &btr_search_sys.get_part(*this)->latch;
 #if !defined NO_ELISION && !defined SUX_LOCK_GENERIC
   if (xbegin())
   {
@@ -1302,6 +1302,33 @@ class buf_pool_t
   /** Clean up after successful create() */
   void close();
 
+#ifdef HAVE_LIBNUMA
+  /** Page frames are placed on the NUMA nodes in a round-robin fashion
+  in address ranges of this size when innodb_numa_local is set */
+  static constexpr size_t NUMA_STRIPE= 2U << 20;
+
+  /** @return index of numa_nodes[] of the node of a page frame */
+  ulint numa_node_of(const byte *frame) const
+  {
+    ut_ad(numa_n_nodes);
+    return (size_t(frame) / NUMA_STRIPE) % numa_n_nodes;
+  }
+
+  /** @return index of numa_nodes[] of the node of the current thread */
+  ulint numa_local_node() const;
+
+  /** Bind page frames to NUMA nodes according to numa_node_of().
+  @param mem   start of the memory
+  @param size  size of the memory, in bytes */
+  void numa_bind(void *mem, size_t size) const;
+private:
+  /** Initialize numa_nodes[] if innodb_numa_local is in effect */
+  void numa_create();
+  /** Free numa_nodes[] */
+  void numa_close();
+public:
+#endif /* HAVE_LIBNUMA */
+
   /** Resize from srv_buf_pool_old_size to srv_buf_pool_size. */
   inline void resize();
 
@@ -1582,6 +1609,17 @@ class buf_pool_t
 	chunk_t*	chunks;		/*!< buffer pool chunks */
 	chunk_t*	chunks_old;	/*!< old buffer pool chunks to be freed
 					after resizing buffer pool */
+#ifdef HAVE_LIBNUMA
+  /** number of NUMA nodes that the page frames are placed on,
+  or 0 if innodb_numa_local is not in effect */
+  ulint numa_n_nodes;
+  /** the NUMA nodes that the page frames are placed on */
+  int *numa_nodes;
+  /** number of elements in numa_cpu_node[] */
+  int numa_n_cpus;
+  /** mapping of CPU numbers to indexes of numa_nodes[] */
+  byte *numa_cpu_node;
+#endif /* HAVE_LIBNUMA */
 	/** current pool size in pages */
 	Atomic_counter<ulint> curr_size;
 	/** read-ahead request size in pages */
@@ -35,6 +35,11 @@ void buf_load_start();
 /** Abort a currently running buffer pool load. */
 void buf_load_abort();
 
+/** Start a buffer pool dump if innodb_buffer_pool_dump_interval has
+passed since the previous one. Invoked by srv_master_callback().
+@param counter_time  microsecond_interval_timer() */
+void buf_dump_at_interval(ulonglong counter_time);
+
 /** Start async buffer pool load, if srv_buffer_pool_load_at_startup was set.*/
 void buf_load_at_startup();
 
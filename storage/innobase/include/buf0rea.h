@@ -53,6 +53,24 @@ void buf_read_page_background(fil_space_t *space, const page_id_t page_id,
                               ulint zip_size)
   MY_ATTRIBUTE((nonnull));
 
+/** Maximum number of pages that buf_read_pages_merged() reads */
+constexpr ulint BUF_READ_MERGE_PAGES= 64;
+
+/** Read consecutive pages of a tablespace that are not in the buffer pool
+with one synchronous read request. This is used for loading the buffer
+pool, and must not be used for the change buffer, the doublewrite buffer
+or the change buffer bitmap pages.
+@param space     tablespace; will be released
+@param page_id   the first page
+@param n         number of pages, at most BUF_READ_MERGE_PAGES
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@param buf       buffer for n pages of the physical page size,
+                 aligned to srv_page_size
+@return number of pages that were read */
+ulint buf_read_pages_merged(fil_space_t *space, const page_id_t page_id,
+                            ulint n, ulint zip_size, byte *buf)
+  MY_ATTRIBUTE((nonnull));
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -101,6 +119,23 @@ which could result in a deadlock if the OS does not support asynchronous io.
 ulint
 buf_read_ahead_linear(const page_id_t page_id, ulint zip_size, bool ibuf);
 
+/** Read ahead the leaf pages that a scan of an index is predicted to
+access next (innodb_read_ahead_pages). The pages are
+page_no, page_no + stride, page_no + 2 * stride, and so on, as far as
+they are within the tablespace.
+NOTE: the calling thread may own latches on pages: to avoid deadlocks this
+function must be written such that it cannot end up waiting for these
+latches!
+@param space     tablespace
+@param page_no   the first page to read
+@param stride    difference of the page numbers of consecutive pages
+@param n         number of pages to read
+@param zip_size  ROW_FORMAT=COMPRESSED page size, or 0
+@return number of page read requests issued */
+ulint buf_read_ahead_pages(fil_space_t *space, uint32_t page_no,
+                           int32_t stride, ulint n, ulint zip_size)
+  MY_ATTRIBUTE((nonnull));
+
 /** Issue read requests for pages that need to be recovered.
 @param space_id	tablespace identifier
 @param page_nos	page numbers to read, in ascending order */
@@ -132,6 +132,8 @@ struct page_recv_t
     RECV_WILL_NOT_READ,
     /** page is being read */
     RECV_BEING_READ,
+    /** the page will be reinitialized by a recovery worker task */
+    RECV_BEING_INITIALIZED,
     /** log records are being applied on the page */
     RECV_BEING_PROCESSED
   } state= RECV_NOT_PROCESSED;
@@ -200,6 +202,8 @@ struct recv_sys_t
   pthread_cond_t cond;
   /** whether recv_apply_hashed_log_recs() is running */
   bool apply_batch_on;
+  /** number of submitted recv_init_batch that have not completed */
+  uint32_t n_init_batches;
   /** set when finding a corrupt log block or record, or there is a
   log parsing buffer overflow */
   bool found_corrupt_log;
@@ -277,6 +281,17 @@ struct recv_sys_t
   @retval -1      if the page cannot be recovered due to corruption */
   buf_block_t *recover_low(const page_id_t page_id);
 
+  /** Wait for a recv_init_batch to complete.
+  @param last_batch  whether this is the last batch of recovery */
+  inline void wait_init_batch(bool last_batch);
+
+  /** Submit pages that will be initialized based on redo log records
+  to a recovery worker task.
+  @param p           iterator pointing to a page in RECV_WILL_NOT_READ
+                     state; will be advanced past the submitted pages
+  @param last_batch  whether this is the last batch of recovery */
+  inline void submit_init(map::iterator &p, bool last_batch);
+
   /** All found log files (multiple ones are possible if we are upgrading
   from before MariaDB Server 10.5.1) */
   std::vector<log_file_t> files;
@@ -384,6 +399,11 @@ struct recv_sys_t
   /** Possibly finish a recovery batch. */
   inline void maybe_finish_batch();
 
+  /** Initialize pages based on redo log records in a worker task.
+  @param space_id  tablespace identifier
+  @param page_nos  page numbers, in ascending order */
+  void apply_init(uint32_t space_id, span<const uint32_t> page_nos);
+
   /** @return whether data file corruption was found */
   bool is_corrupt_fs() const { return UNIV_UNLIKELY(found_corrupt_fs); }
   /** @return whether log file corruption was found */
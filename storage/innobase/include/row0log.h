@@ -37,6 +37,11 @@ Created 2011-05-26 Marko Makela
 class ut_stage_alter_t;
 
 extern Atomic_counter<ulint> onlineddl_rowlog_rows;
+extern Atomic_counter<ulint> onlineddl_rowlog_applied;
+/** Number of logged operations applied by row_merge_pll_build_t */
+extern Atomic_counter<ulint> onlineddl_rowlog_applied_in_sort;
+/** Number of row_merge_pll_build_t tasks that were started */
+extern Atomic_counter<ulint> onlineddl_sort_tasks;
 extern ulint onlineddl_rowlog_pct_used;
 extern ulint onlineddl_pct_progress;
 
@@ -208,13 +213,15 @@ interrupted)
 @param[in,out]	stage	performance schema accounting object, used by
 ALTER TABLE. stage->begin_phase_log_index() will be called initially and then
 stage->inc() will be called for each block of log that is applied.
+@param[out]	n_applied	number of applied operations, or nullptr
 @return DB_SUCCESS, or error code on failure */
 dberr_t
 row_log_apply(
 	const trx_t*		trx,
 	dict_index_t*		index,
 	struct TABLE*		table,
-	ut_stage_alter_t*	stage)
+	ut_stage_alter_t*	stage,
+	ulint*			n_applied = nullptr)
 	MY_ATTRIBUTE((warn_unused_result));
 
 /** Get the n_core_fields of online log for the index
@@ -0,0 +1,168 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pscan.h
+Parallel scan of a clustered index in a consistent read view
+*******************************************************/
+
+#pragma once
+
+#include "row0mysql.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace tpool { class waitable_task; }
+
+/** Number of table scans that were executed by row_pscan_t
+(Innodb_parallel_read_scans) */
+extern Atomic_counter<ulint> row_pscan_n_scans;
+
+/** A non-locking scan of the clustered index that is split into
+key ranges, which are read by srv_thread_pool tasks in the read view
+of the transaction of a single consumer. The rows are converted to
+the MySQL format by the tasks and delivered to the consumer in batches,
+in no particular order.
+
+The tasks block while the consumer is not reading. So that they cannot
+occupy all srv_thread_pool workers, the number of tasks of all parallel
+scans is limited to the number of CPUs, and a scan that cannot reserve
+at least two tasks is left to row_search_mvcc(). */
+class row_pscan_t
+{
+public:
+  /** Number of rows in a batch that is handed over to the consumer */
+  static constexpr ulint BATCH_ROWS= 64;
+
+  /** Constructor.
+  @param prebuilt   cursor of the consumer; the template must be built
+  @param n_threads  maximum number of concurrent tasks */
+  row_pscan_t(row_prebuilt_t *prebuilt, ulint n_threads);
+  ~row_pscan_t();
+
+  /** Check whether a table scan can be executed by row_pscan_t.
+  @param prebuilt  cursor with a built template
+  @return whether a parallel scan is possible */
+  static bool is_supported(const row_prebuilt_t *prebuilt);
+
+  /** Open the read view, partition the clustered index, and start
+  the tasks.
+  @retval DB_SUCCESS      if the scan was started
+  @retval DB_UNSUPPORTED  if the index is too small to be partitioned,
+                          or too many parallel scans are running
+  @return error code */
+  dberr_t start();
+
+  /** Fetch the next row.
+  @param buf  row buffer in the MySQL format
+  @retval DB_SUCCESS       if a row was fetched
+  @retval DB_END_OF_INDEX  if all rows have been fetched
+  @return error code */
+  dberr_t fetch(byte *buf);
+
+private:
+  /** A key range [low,high) of the clustered index */
+  struct range_t
+  {
+    /** lower bound, or nullptr for the start of the index */
+    const dtuple_t *low;
+    /** upper bound, or nullptr for the end of the index */
+    const dtuple_t *high;
+  };
+
+  /** A batch of rows in the MySQL format */
+  struct batch_t
+  {
+    /** rows; each is followed by DATA_ROW_ID_LEN bytes of DB_ROW_ID */
+    byte *rows;
+    /** number of rows */
+    ulint n_rows;
+    /** number of rows fetched by the consumer */
+    ulint n_fetched;
+  };
+
+  /** Split the clustered index into ranges.
+  @return error code */
+  dberr_t partition();
+
+  /** Scan the ranges in a srv_thread_pool task */
+  void worker();
+  /** srv_thread_pool callback */
+  static void worker_callback(void *arg)
+  { static_cast<row_pscan_t*>(arg)->worker(); }
+
+  /** Scan a range of the clustered index.
+  @param range  the range
+  @param batch  batch to fill; nullptr if the scan was aborted
+  @return error code */
+  dberr_t scan_range(const range_t &range, batch_t *&batch);
+
+  /** Reserve tasks from the limit of all parallel scans.
+  @param n  desired number of tasks
+  @return number of reserved tasks, between 0 and n */
+  static ulint reserve_tasks(ulint n);
+  /** Release tasks that were reserved by reserve_tasks().
+  @param n  number of tasks */
+  static void release_tasks(ulint n);
+
+  /** Hand over a full batch (if any) and acquire an empty one.
+  @param batch  batch to be handed over to the consumer, or nullptr
+  @return an empty batch
+  @retval nullptr if the scan was aborted */
+  batch_t *exchange(batch_t *batch);
+
+  /** cursor of the consumer */
+  row_prebuilt_t *const m_prebuilt;
+  /** maximum number of concurrent tasks */
+  const ulint m_n_threads;
+  /** size of a batch_t::rows element, in bytes */
+  const ulint m_row_size;
+  /** memory heap for range bounds */
+  mem_heap_t *const m_heap;
+  /** the ranges */
+  std::vector<range_t> m_ranges;
+  /** the next range to be scanned */
+  std::atomic<ulint> m_next_range{0};
+  /** the worker tasks */
+  std::vector<tpool::waitable_task*> m_tasks;
+  /** number of tasks reserved by reserve_tasks() */
+  ulint m_reserved= 0;
+  /** memory for m_batches */
+  byte *m_buf= nullptr;
+  /** all batches */
+  std::vector<batch_t> m_batches;
+  /** whether the consumer is no longer interested in the rows */
+  std::atomic<bool> m_abort{false};
+
+  /** protects the members below */
+  std::mutex m_mutex;
+  /** signalled when m_full, m_free, m_active or m_err changes */
+  std::condition_variable m_cond;
+  /** batches that are ready for the consumer */
+  std::vector<batch_t*> m_full;
+  /** batches that are available to the tasks */
+  std::vector<batch_t*> m_free;
+  /** the batch that the consumer is reading */
+  batch_t *m_current= nullptr;
+  /** number of tasks that have not completed */
+  ulint m_active= 0;
+  /** the first error that was reported by a task */
+  dberr_t m_err= DB_SUCCESS;
+};
@@ -179,6 +179,10 @@ extern my_bool	srv_file_per_table;
 
 /** Sort buffer size in index creation */
 extern ulong	srv_sort_buf_size;
+/** innodb_sort_threads: number of threads that merge sort and load the
+indexes of one ALTER TABLE */
+extern ulong	srv_sort_threads;
+constexpr ulong	innodb_sort_threads_MAX= 64;
 /** Maximum modification log file size for online index creation */
 extern unsigned long long	srv_online_max_size;
 
@@ -188,6 +192,9 @@ use simulated aio.
 Currently we support native aio on windows and linux */
 extern my_bool	srv_use_native_aio;
 extern my_bool	srv_numa_interleave;
+/** innodb_numa_local: whether to place the buffer pool page frames
+on all NUMA nodes and to prefer frames that are local to the thread */
+extern my_bool	srv_numa_local;
 
 /* Use atomic writes i.e disable doublewrite buffer */
 extern my_bool srv_use_atomic_writes;
@@ -251,6 +258,8 @@ extern ulint	srv_buf_pool_base_size;
 extern ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong	srv_buf_pool_dump_pct;
+/** innodb_buffer_pool_dump_interval, in seconds */
+extern ulong	srv_buf_pool_dump_interval;
 #ifdef UNIV_DEBUG
 /** Abort load after this amount of pages */
 extern ulong srv_buf_pool_load_pages_abort;
@@ -264,6 +273,7 @@ extern ulong	srv_checksum_algorithm;
 extern uint	srv_n_file_io_threads;
 extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
+extern ulong	srv_read_ahead_pages;
 extern uint	srv_n_read_io_threads;
 extern uint	srv_n_write_io_threads;
 
@@ -682,9 +692,14 @@ struct export_var_t{
 	ulong innodb_instant_alter_column;
 
 	ulint innodb_onlineddl_rowlog_rows;	/*!< Online alter rows */
+	ulint innodb_onlineddl_rowlog_applied;	/*!< Online alter rows
+						applied from the row log */
 	ulint innodb_onlineddl_rowlog_pct_used; /*!< Online alter percentage
 						of used row log buffer */
 	ulint innodb_onlineddl_pct_progress;	/*!< Online alter progress */
+	ulint innodb_onlineddl_sort_tasks;	/*!< Online alter sort tasks */
+	ulint innodb_onlineddl_rowlog_applied_in_sort; /*!< Online alter
+						rows applied by the sort tasks */
 
 	int64_t innodb_page_compression_saved;/*!< Number of bytes saved
 						by page compression */
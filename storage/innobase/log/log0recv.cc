@@ -1373,6 +1373,7 @@ void recv_sys_t::create()
 
 	apply_log_recs = false;
 	apply_batch_on = false;
+	n_init_batches = 0;
 
 	len = 0;
 	offset = 0;
@@ -3271,7 +3272,8 @@ inline buf_block_t *recv_sys_t::recover_low(const page_id_t page_id,
   mysql_mutex_assert_owner(&mutex);
   ut_ad(p->first == page_id);
   page_recv_t &recs= p->second;
-  ut_ad(recs.state == page_recv_t::RECV_WILL_NOT_READ);
+  ut_ad(recs.state == page_recv_t::RECV_WILL_NOT_READ ||
+        recs.state == page_recv_t::RECV_BEING_INITIALIZED);
   buf_block_t* block= nullptr;
   mlog_init_t::init &i= mlog_init.last(page_id);
   const lsn_t end_lsn= recs.log.last()->lsn;
@@ -3351,7 +3353,9 @@ buf_block_t *recv_sys_t::recover_low(const page_id_t page_id)
   mysql_mutex_lock(&mutex);
   map::iterator p= pages.find(page_id);
 
-  if (p != pages.end() && p->second.state == page_recv_t::RECV_WILL_NOT_READ)
+  if (p != pages.end() &&
+      (p->second.state == page_recv_t::RECV_WILL_NOT_READ ||
+       p->second.state == page_recv_t::RECV_BEING_INITIALIZED))
   {
     mtr_t mtr;
     block= recover_low(page_id, p, mtr, free_block);
@@ -3365,6 +3369,141 @@ buf_block_t *recv_sys_t::recover_low(const page_id_t page_id)
   return block;
 }
 
+/** A batch of pages that will be initialized based on redo log records
+by a recovery worker task */
+struct recv_init_batch : tpool::task
+{
+  /** maximum number of pages in a batch; @see recv_read_in_area() */
+  static constexpr uint32_t MAX_PAGES= 32;
+
+  /** tablespace identifier */
+  const uint32_t space_id;
+  /** number of pages in the batch */
+  uint32_t n_pages= 0;
+  /** page numbers, in ascending order */
+  uint32_t page_nos[MAX_PAGES];
+
+  explicit recv_init_batch(uint32_t space_id) :
+    tpool::task(run, this), space_id(space_id) {}
+
+  void release() override { delete this; }
+
+private:
+  static void run(void *arg)
+  {
+    recv_init_batch *batch= static_cast<recv_init_batch*>(arg);
+    recv_sys.apply_init(batch->space_id, {batch->page_nos, batch->n_pages});
+  }
+};
+
+/** Initialize pages based on redo log records in a worker task.
+@param space_id  tablespace identifier
+@param page_nos  page numbers, in ascending order */
+void recv_sys_t::apply_init(uint32_t space_id,
+                            span<const uint32_t> page_nos)
+{
+  buf_block_t *free_block= nullptr;
+
+  for (const uint32_t page_no : page_nos)
+  {
+    const page_id_t page_id{space_id, page_no};
+    if (!free_block)
+      free_block= buf_LRU_get_free_block(false);
+
+    mysql_mutex_lock(&mutex);
+    map::iterator p= pages.find(page_id);
+    /* Another thread may have accessed the page in buf_page_get_gen()
+    meanwhile, and recover_low(page_id) will then have recovered the
+    page and removed it from pages. */
+    if (p != pages.end() &&
+        p->second.state == page_recv_t::RECV_BEING_INITIALIZED)
+    {
+      mtr_t mtr;
+      if (recover_low(page_id, p, mtr, free_block))
+        free_block= nullptr;
+    }
+    mysql_mutex_unlock(&mutex);
+  }
+
+  if (free_block)
+    buf_pool.free_block(free_block);
+
+  mysql_mutex_lock(&mutex);
+  ut_ad(n_init_batches);
+  n_init_batches--;
+  pthread_cond_broadcast(&cond);
+  mysql_mutex_unlock(&mutex);
+}
+
+/** Wait for a recv_init_batch to complete.
+@param last_batch  whether this is the last batch of recovery */
+inline void recv_sys_t::wait_init_batch(bool last_batch)
+{
+  mysql_mutex_assert_owner(&mutex);
+  ut_ad(n_init_batches);
+
+  if (last_batch)
+    my_cond_wait(&cond, &mutex.m_mutex);
+  else
+  {
+    /* Like the wait at the end of apply(), do not hold log_sys.latch
+    while the workers may be waiting for buf_LRU_get_free_block(). */
+#ifndef SUX_LOCK_GENERIC
+    ut_ad(log_sys.latch.is_write_locked());
+#endif
+    log_sys.latch.wr_unlock();
+    timespec abstime;
+    set_timespec_nsec(abstime, 500000000ULL); /* 0.5s */
+    my_cond_timedwait(&cond, &mutex.m_mutex, &abstime);
+    mysql_mutex_unlock(&mutex);
+    log_sys.latch.wr_lock(SRW_LOCK_CALL);
+    mysql_mutex_lock(&mutex);
+  }
+}
+
+/** Submit pages that will be initialized based on redo log records
+to a recovery worker task.
+@param p           iterator pointing to a page in RECV_WILL_NOT_READ state;
+                   will be advanced past the submitted pages
+@param last_batch  whether this is the last batch of recovery */
+inline void recv_sys_t::submit_init(map::iterator &p, bool last_batch)
+{
+  mysql_mutex_assert_owner(&mutex);
+  ut_ad(p->second.state == page_recv_t::RECV_WILL_NOT_READ);
+
+  /* Bound the number of buffer pool blocks that the workers may be
+  holding at a time, as well as the number of queued tasks. */
+  const uint32_t max_batches= std::max(my_getncpus(), 1);
+  while (n_init_batches >= max_batches && !is_corrupt_log() &&
+         !is_corrupt_fs())
+    wait_init_batch(last_batch);
+
+  /* The wait may have released the mutex; reposition the iterator. */
+  const page_id_t page_id{p->first};
+  p= pages.lower_bound(page_id);
+
+  recv_init_batch *batch= new recv_init_batch(page_id.space());
+
+  for (; p != pages.end() && p->first.space() == page_id.space() &&
+         batch->n_pages < recv_init_batch::MAX_PAGES; p++)
+  {
+    if (p->second.state == page_recv_t::RECV_WILL_NOT_READ)
+    {
+      p->second.state= page_recv_t::RECV_BEING_INITIALIZED;
+      batch->page_nos[batch->n_pages++]= p->first.page_no();
+    }
+  }
+
+  if (!batch->n_pages)
+  {
+    delete batch;
+    return;
+  }
+
+  n_init_batches++;
+  srv_thread_pool->submit_task(batch);
+}
+
 inline fil_space_t *fil_system_t::find(const char *path) const
 {
   mysql_mutex_assert_owner(&mutex);
@@ -3501,26 +3640,27 @@ void recv_sys_t::apply(bool last_batch)
         else
           deferred_spaces.defers.erase(d);
         if (!free_block)
-          goto next_free_block;
+        {
+          mysql_mutex_unlock(&mutex);
+          free_block= buf_LRU_get_free_block(false);
+          mysql_mutex_lock(&mutex);
+        }
         p= pages.lower_bound(page_id);
         continue;
       }
 
       switch (p->second.state) {
       case page_recv_t::RECV_BEING_READ:
+      case page_recv_t::RECV_BEING_INITIALIZED:
       case page_recv_t::RECV_BEING_PROCESSED:
         p++;
         continue;
       case page_recv_t::RECV_WILL_NOT_READ:
-        if (UNIV_LIKELY(!!recover_low(page_id, p, mtr, free_block)))
-        {
-next_free_block:
-          mysql_mutex_unlock(&mutex);
-          free_block= buf_LRU_get_free_block(false);
-          mysql_mutex_lock(&mutex);
-          break;
-        }
-        ut_ad(p == pages.end() || p->first > page_id);
+        /* Pages that are being read will be recovered in
+        buf_page_t::read_complete(). Pages that can be initialized
+        without reading them are handed to worker tasks, so that
+        all of the log apply will proceed in parallel. */
+        submit_init(p, last_batch);
         continue;
       case page_recv_t::RECV_NOT_PROCESSED:
         recv_read_in_area(page_id, p);
@@ -3537,14 +3677,14 @@ void recv_sys_t::apply(bool last_batch)
     for (;;)
     {
       const bool empty= pages.empty();
-      if (empty && !buf_pool.n_pend_reads)
+      if (empty && !buf_pool.n_pend_reads && !n_init_batches)
         break;
 
       if (!is_corrupt_fs() && !is_corrupt_log())
       {
         if (last_batch)
         {
-          if (!empty)
+          if (!empty || n_init_batches)
             my_cond_wait(&cond, &mutex.m_mutex);
           else
           {
@@ -3572,6 +3712,9 @@ void recv_sys_t::apply(bool last_batch)
       if (is_corrupt_fs() && !srv_force_recovery)
         sql_print_information("InnoDB: Set innodb_force_recovery=1"
                               " to ignore corrupted pages.");
+      /* Any submitted recv_init_batch will access recv_sys. */
+      while (n_init_batches)
+        wait_init_batch(last_batch);
       return;
     }
   }
@@ -43,6 +43,9 @@ Created 2011-05-26 Marko Makela
 #include <map>
 
 Atomic_counter<ulint> onlineddl_rowlog_rows;
+Atomic_counter<ulint> onlineddl_rowlog_applied;
+Atomic_counter<ulint> onlineddl_rowlog_applied_in_sort;
+Atomic_counter<ulint> onlineddl_sort_tasks;
 ulint onlineddl_rowlog_pct_used;
 ulint onlineddl_pct_progress;
 
@@ -2669,6 +2672,7 @@ row_log_table_apply_ops(
 		truncated. Now that the parse buffer was extended,
 		it should proceed beyond the old end of the buffer. */
 		ut_a(mrec > mrec_end);
+		onlineddl_rowlog_applied++;
 
 		index->online_log->head.bytes = ulint(mrec - mrec_end);
 		next_mrec += index->online_log->head.bytes;
@@ -2767,7 +2771,13 @@ row_log_table_apply_ops(
 
 		if (error != DB_SUCCESS) {
 			goto func_exit;
-		} else if (next_mrec == next_mrec_end) {
+		}
+
+		if (next_mrec) {
+			onlineddl_rowlog_applied++;
+		}
+
+		if (next_mrec == next_mrec_end) {
 			/* The record happened to end on a block boundary.
 			Do we have more blocks left? */
 			if (has_index_lock) {
@@ -3399,6 +3409,7 @@ interrupted)
 ALTER TABLE. If not NULL, then stage->inc() will be called for each block
 of log that is applied or nullptr when row log applied done by DML
 thread.
+@param[in,out]	n_applied	incremented for each applied operation
 @return DB_SUCCESS, or error code on failure */
 static
 dberr_t
@@ -3406,7 +3417,8 @@ row_log_apply_ops(
 	const trx_t*		trx,
 	dict_index_t*		index,
 	row_merge_dup_t*	dup,
-	ut_stage_alter_t*	stage)
+	ut_stage_alter_t*	stage,
+	ulint&			n_applied)
 {
 	dberr_t		error;
 	const mrec_t*	mrec	= NULL;
@@ -3578,6 +3590,8 @@ row_log_apply_ops(
 		truncated. Now that the parse buffer was extended,
 		it should proceed beyond the old end of the buffer. */
 		ut_a(mrec > mrec_end);
+		onlineddl_rowlog_applied++;
+		n_applied++;
 
 		index->online_log->head.bytes = ulint(mrec - mrec_end);
 		next_mrec += index->online_log->head.bytes;
@@ -3658,7 +3672,14 @@ row_log_apply_ops(
 
 		if (error != DB_SUCCESS) {
 			goto func_exit;
-		} else if (next_mrec == next_mrec_end) {
+		}
+
+		if (next_mrec) {
+			onlineddl_rowlog_applied++;
+			n_applied++;
+		}
+
+		if (next_mrec == next_mrec_end) {
 			/* The record happened to end on a block boundary.
 			Do we have more blocks left? */
 			if (has_index_lock) {
@@ -3734,16 +3755,19 @@ interrupted)
 ALTER TABLE. stage->begin_phase_log_index() will be called initially and then
 stage->inc() will be called for each block of log that is applied or nullptr
 when row log has been applied by DML thread.
+@param[out]	n_applied	number of applied operations, or nullptr
 @return DB_SUCCESS, or error code on failure */
 dberr_t
 row_log_apply(
 	const trx_t*		trx,
 	dict_index_t*		index,
 	struct TABLE*		table,
-	ut_stage_alter_t*	stage)
+	ut_stage_alter_t*	stage,
+	ulint*			n_applied)
 {
 	dberr_t		error;
 	row_merge_dup_t	dup = { index, table, NULL, 0 };
+	ulint		applied = 0;
 	DBUG_ENTER("row_log_apply");
 
 	ut_ad(dict_index_is_online_ddl(index)
@@ -3760,7 +3784,7 @@ row_log_apply(
 	index->lock.x_lock(SRW_LOCK_CALL);
 
 	if (index->online_log && !index->table->corrupted) {
-		error = row_log_apply_ops(trx, index, &dup, stage);
+		error = row_log_apply_ops(trx, index, &dup, stage, applied);
 	} else {
 		error = DB_SUCCESS;
 	}
@@ -3780,6 +3804,10 @@ row_log_apply(
 
 	index->lock.x_unlock();
 
+	if (n_applied) {
+		*n_applied = applied;
+	}
+
 	DBUG_RETURN(error);
 }
 
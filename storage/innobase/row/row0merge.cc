@@ -4600,6 +4600,224 @@ row_merge_is_index_usable(
 		   || trx->read_view.changes_visible(index->trx_id)));
 }
 
+/** Merge sort and load of indexes by srv_thread_pool tasks, for
+row_merge_build_indexes() with innodb_sort_threads>1. The thread of
+ALTER TABLE builds the unique indexes, because a duplicate is reported
+in its MySQL table, and joins the tasks when it is done with them.
+In online ADD INDEX, each task also applies the log of the concurrent
+DML to the index that it built, so that the logs of several indexes
+are applied at the same time. The thread of ALTER TABLE only applies
+what was logged after that, and completes the indexes. */
+class row_merge_pll_build_t
+{
+public:
+	/** An index to be merge sorted and loaded */
+	struct job_t
+	{
+		/** position in indexes[] of row_merge_build_indexes() */
+		ulint		pos;
+		dict_index_t*	index;
+		merge_file_t*	file;
+		/** innodb_onlineddl_pct_progress before the job */
+		double		pct_progress;
+		/** estimated share of the merge sort and of the load */
+		double		pct_sort;
+		double		pct_insert;
+		/** the outcome */
+		dberr_t		error;
+	};
+
+	/** Constructor.
+	@param trx		transaction
+	@param old_table	table where rows are read from
+	@param space_id	tablespace of the indexes
+	@param apply_log	whether to apply the online log of the indexes
+	@param n		maximum number of jobs */
+	row_merge_pll_build_t(trx_t* trx, const dict_table_t* old_table,
+			      ulint space_id, bool apply_log, ulint n)
+		: m_trx(trx), m_old_table(old_table), m_space_id(space_id),
+		  m_apply_log(apply_log),
+		  m_jobs(static_cast<job_t*>(
+				 ut_malloc_nokey(n * sizeof *m_jobs))),
+		  m_n_jobs(0), m_next(0), m_abort(false), m_n_tasks(0)
+	{}
+
+	~row_merge_pll_build_t()
+	{
+		abort();
+		ut_free(m_jobs);
+	}
+
+	/** Add an index to be built. */
+	void add(ulint pos, dict_index_t* index, merge_file_t* file,
+		 double pct_progress, double pct_sort, double pct_insert)
+	{
+		job_t&	job = m_jobs[m_n_jobs++];
+		job.pos = pos;
+		job.index = index;
+		job.file = file;
+		job.pct_progress = pct_progress;
+		job.pct_sort = pct_sort;
+		job.pct_insert = pct_insert;
+		job.error = DB_SUCCESS;
+	}
+
+	/** @return whether the index at a position of indexes[] is built
+	by a job */
+	bool is_job(ulint pos) const
+	{
+		for (ulint i = 0; i < m_n_jobs; i++) {
+			if (m_jobs[i].pos == pos) {
+				return(true);
+			}
+		}
+		return(false);
+	}
+
+	ulint n_jobs() const { return(m_n_jobs); }
+	const job_t& job(ulint i) const { return(m_jobs[i]); }
+
+	/** Start the tasks.
+	@param n_threads	innodb_sort_threads */
+	void start(ulint n_threads)
+	{
+		m_n_tasks = std::min(n_threads - 1, m_n_jobs);
+		for (ulint i = 0; i < m_n_tasks; i++) {
+			m_tasks[i] = new tpool::waitable_task(task, this);
+			srv_thread_pool->submit_task(m_tasks[i]);
+		}
+	}
+
+	/** Build the remaining indexes in this thread too, and wait
+	for the tasks to finish. */
+	void finish()
+	{
+		run();
+		wait();
+	}
+
+	/** Skip the indexes that are not started yet, and wait for the
+	tasks to finish. */
+	void abort()
+	{
+		m_abort = true;
+		wait();
+	}
+
+private:
+	static void task(void* arg)
+	{
+		onlineddl_sort_tasks++;
+		static_cast<row_merge_pll_build_t*>(arg)->run();
+	}
+
+	void wait()
+	{
+		for (ulint i = 0; i < m_n_tasks; i++) {
+			m_tasks[i]->wait();
+			delete m_tasks[i];
+		}
+		m_n_tasks = 0;
+	}
+
+	/** Build indexes until there are no more jobs */
+	void run();
+
+	trx_t*			m_trx;
+	const dict_table_t*	m_old_table;
+	ulint			m_space_id;
+	/** whether the indexes are created online in m_old_table */
+	bool			m_apply_log;
+	job_t*			m_jobs;
+	ulint			m_n_jobs;
+	/** the next job to be started */
+	std::atomic<ulint>	m_next;
+	/** whether to skip the jobs that are not started yet */
+	std::atomic<bool>	m_abort;
+	tpool::waitable_task*	m_tasks[innodb_sort_threads_MAX];
+	ulint			m_n_tasks;
+};
+
+void row_merge_pll_build_t::run()
+{
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	block = NULL;
+	row_merge_block_t*	crypt_block = NULL;
+	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
+	ulint			i;
+
+	while (!m_abort && (i = m_next++) < m_n_jobs) {
+		job_t&	job = m_jobs[i];
+
+		if (!block) {
+			block = alloc.allocate_large(3 * srv_sort_buf_size,
+						     &block_pfx);
+			if (block && srv_encrypt_log) {
+				crypt_block = alloc.allocate_large(
+					3 * srv_sort_buf_size, &crypt_pfx);
+				if (!crypt_block) {
+					alloc.deallocate_large(block,
+							       &block_pfx);
+					block = NULL;
+				}
+			}
+			if (!block) {
+				job.error = DB_OUT_OF_MEMORY;
+				continue;
+			}
+		}
+
+		/* The index is not unique, so that no duplicate is
+		reported in the MySQL table. The progress of the
+		ALTER TABLE thread and the performance schema stage
+		are only updated by that thread. */
+		row_merge_dup_t	dup = {job.index, NULL, NULL, 0};
+
+		job.error = row_merge_sort(m_trx, &dup, job.file, block,
+					   &tmpfd, false, job.pct_progress,
+					   job.pct_sort, crypt_block,
+					   m_space_id, NULL);
+
+		if (job.error == DB_SUCCESS) {
+			BtrBulk	btr_bulk(job.index, m_trx);
+
+			job.error = row_merge_insert_index_tuples(
+				job.index, m_old_table, job.file->fd, block,
+				NULL, &btr_bulk, job.file->n_rec,
+				job.pct_progress + job.pct_sort,
+				job.pct_insert, crypt_block, m_space_id, NULL);
+
+			job.error = btr_bulk.finish(job.error);
+		}
+
+		if (job.error == DB_SUCCESS && m_apply_log) {
+			/* Catch up with the concurrent DML. The index
+			stays ONLINE_INDEX_CREATION until the thread of
+			ALTER TABLE applies the rest of the log. */
+			ulint	n_applied;
+			job.error = row_log_apply(m_trx, job.index, NULL, NULL,
+						  &n_applied);
+			onlineddl_rowlog_applied_in_sort += n_applied;
+		}
+
+		if (job.error != DB_SUCCESS) {
+			m_abort = true;
+		}
+	}
+
+	row_merge_file_destroy_low(tmpfd);
+
+	if (block) {
+		alloc.deallocate_large(block, &block_pfx);
+	}
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx);
+	}
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4665,6 +4883,7 @@ row_merge_build_indexes(
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	bool			fts_psort_initiated = false;
+	row_merge_pll_build_t*	pll = NULL;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4825,6 +5044,47 @@ row_merge_build_indexes(
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
+	if (srv_sort_threads > 1) {
+		/* Let srv_thread_pool build the non-unique indexes
+		while this thread builds the others. */
+		for (ulint k = 0, i = 0; i < n_indexes; i++) {
+			if (dict_index_is_spatial(indexes[i])) {
+				continue;
+			}
+
+			merge_file_t*	file = &merge_files[k++];
+
+			if ((indexes[i]->type & DICT_FTS)
+			    || dict_index_is_unique(indexes[i])
+			    || file->fd == OS_FILE_CLOSED) {
+				continue;
+			}
+
+			if (!pll) {
+				pll = UT_NEW_NOKEY(row_merge_pll_build_t(
+					trx, old_table,
+					new_table->space_id,
+					online && old_table == new_table,
+					n_merge_files));
+			}
+
+			pct_cost = (COST_BUILD_INDEX_STATIC +
+				    (total_dynamic_cost
+				     * static_cast<double>(file->offset)
+				     / static_cast<double>(total_index_blocks)))
+				/ (total_static_cost + total_dynamic_cost)
+				* 100;
+
+			pll->add(i, indexes[i], file, pct_progress,
+				 pct_cost * PCT_COST_MERGESORT_INDEX,
+				 pct_cost * PCT_COST_INSERT_INDEX);
+		}
+
+		if (pll) {
+			pll->start(srv_sort_threads);
+		}
+	}
+
 	for (ulint k = 0, i = 0; i < n_indexes; i++) {
 		dict_index_t*	sort_idx = indexes[i];
 
@@ -4832,6 +5092,12 @@ row_merge_build_indexes(
 			continue;
 		}
 
+		if (pll && pll->is_job(i)) {
+			/* The file is freed after the job is done. */
+			k++;
+			continue;
+		}
+
 		if (indexes[i]->type & DICT_FTS) {
 
 			sort_idx = fts_sort_idx;
@@ -4986,7 +5252,44 @@ row_merge_build_indexes(
 		}
 	}
 
+	if (pll) {
+		pll->finish();
+
+		for (i = 0; i < pll->n_jobs(); i++) {
+			if (pll->job(i).error != DB_SUCCESS) {
+				error = pll->job(i).error;
+				trx->error_key_num = key_numbers[pll->job(i).pos];
+				goto func_exit;
+			}
+		}
+
+		for (i = 0; i < pll->n_jobs(); i++) {
+			const row_merge_pll_build_t::job_t&	job
+				= pll->job(i);
+
+			row_merge_file_destroy(job.file);
+
+			if (old_table == new_table && online) {
+				DEBUG_SYNC_C("row_log_apply_before");
+				error = row_log_apply(trx, job.index, table,
+						      stage);
+				DEBUG_SYNC_C("row_log_apply_after");
+
+				if (error != DB_SUCCESS) {
+					trx->error_key_num
+						= key_numbers[job.pos];
+					goto func_exit;
+				}
+			}
+		}
+	}
+
 func_exit:
+	if (pll) {
+		/* Wait for the tasks before their files are freed. */
+		UT_DELETE(pll);
+	}
+
 
 	DBUG_EXECUTE_IF(
 		"ib_build_indexes_too_many_concurrent_trxs",
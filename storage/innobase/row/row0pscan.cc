@@ -0,0 +1,544 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pscan.cc
+Parallel scan of a clustered index in a consistent read view
+*******************************************************/
+
+#include "row0pscan.h"
+#include "row0sel.h"
+#include "row0vers.h"
+#include "btr0pcur.h"
+#include "dict0dict.h"
+#include "rem0cmp.h"
+#include "trx0trx.h"
+#include "srv0srv.h"
+
+/** Number of tasks that are reserved by all parallel scans */
+static std::atomic<ulint> row_pscan_n_tasks;
+
+Atomic_counter<ulint> row_pscan_n_scans;
+
+row_pscan_t::row_pscan_t(row_prebuilt_t *prebuilt, ulint n_threads) :
+  m_prebuilt(prebuilt), m_n_threads(n_threads),
+  m_row_size(prebuilt->mysql_row_len + DATA_ROW_ID_LEN),
+  m_heap(mem_heap_create(1024))
+{
+  ut_ad(n_threads > 1);
+}
+
+row_pscan_t::~row_pscan_t()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_abort= true;
+  }
+  m_cond.notify_all();
+
+  for (tpool::waitable_task *task : m_tasks)
+  {
+    task->wait();
+    delete task;
+  }
+
+  ut_ad(!m_active);
+  release_tasks(m_reserved);
+  ut_free(m_buf);
+  mem_heap_free(m_heap);
+}
+
+/** Reserve tasks from the limit of all parallel scans.
+@param n  desired number of tasks
+@return number of reserved tasks, between 0 and n */
+ulint row_pscan_t::reserve_tasks(ulint n)
+{
+  const ulint limit= ulint(std::max(my_getncpus(), 2));
+  ulint n_tasks= row_pscan_n_tasks.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    if (n_tasks >= limit)
+      return 0;
+    const ulint reserve= std::min(n, limit - n_tasks);
+    if (row_pscan_n_tasks.compare_exchange_weak(n_tasks, n_tasks + reserve))
+      return reserve;
+  }
+}
+
+/** Release tasks that were reserved by reserve_tasks().
+@param n  number of tasks */
+void row_pscan_t::release_tasks(ulint n)
+{
+  ut_d(const ulint n_tasks=) row_pscan_n_tasks.fetch_sub(n);
+  ut_ad(n_tasks >= n);
+}
+
+/** Check whether a table scan can be executed by row_pscan_t.
+@param prebuilt  cursor with a built template
+@return whether a parallel scan is possible */
+bool row_pscan_t::is_supported(const row_prebuilt_t *prebuilt)
+{
+  const dict_table_t *table= prebuilt->table;
+  const dict_index_t *index= prebuilt->index;
+
+  /* Only non-locking reads in a read view are supported. At
+  READ UNCOMMITTED, and for tables without MVCC, row_search_mvcc()
+  would return the latest version of each record. */
+  if (prebuilt->select_lock_type != LOCK_NONE ||
+      prebuilt->trx->isolation_level == TRX_ISO_READ_UNCOMMITTED ||
+      table->is_temporary() || table->no_rollback() ||
+      srv_read_only_mode || srv_force_recovery)
+    return false;
+
+  if (!index || !index->is_primary() || !prebuilt->index_usable ||
+      index->is_corrupted() || !table->is_readable() ||
+      !table->space)
+    return false;
+
+  /* The tasks will invoke row_sel_store_mysql_rec() concurrently.
+  It must not write to prebuilt, which it would do for BLOBs
+  (prebuilt->blob_heap) or FULLTEXT INDEX (prebuilt->fts_doc_id). */
+  if (prebuilt->templ_contains_blob || prebuilt->idx_cond ||
+      prebuilt->pk_filter || prebuilt->in_fts_query ||
+      prebuilt->keep_other_fields_on_keyread ||
+      dict_table_has_fts_index(prebuilt->table))
+    return false;
+
+  for (ulint i= 0; i < prebuilt->n_template; i++)
+  {
+    const mysql_row_templ_t &templ= prebuilt->mysql_template[i];
+    if (templ.is_virtual || DATA_LARGE_MTYPE(templ.type) ||
+        DATA_GEOMETRY_MTYPE(templ.type))
+      return false;
+  }
+
+  return true;
+}
+
+/** Split the clustered index into ranges.
+@return error code */
+dberr_t row_pscan_t::partition()
+{
+  dict_index_t *index= m_prebuilt->index;
+  const ulint n_uniq= dict_index_get_n_unique_in_tree_nonleaf(index);
+  /* Create a few ranges per task, so that the tasks will finish at
+  roughly the same time even if the subtrees are not balanced. */
+  const ulint target= m_n_threads * 4;
+  std::vector<const dtuple_t*> bounds;
+  mem_heap_t *heap= nullptr;
+  rec_offs *offsets= nullptr;
+  dberr_t err;
+  mtr_t mtr;
+
+  mtr.start();
+  /* Prevent any changes to the non-leaf pages. */
+  mtr_s_lock_index(index, &mtr);
+
+  buf_block_t *block= btr_root_block_get(index, RW_S_LATCH, &mtr, &err);
+  if (!block)
+    goto func_exit;
+
+  /* Descend until we find a level that has enough node pointers. */
+  for (ulint level= btr_page_get_level(block->page.frame); level; level--)
+  {
+    uint32_t child= FIL_NULL;
+    bounds.clear();
+
+    for (const buf_block_t *b= block;;)
+    {
+      const page_t *page= b->page.frame;
+      if (btr_page_get_level(page) != level)
+      {
+        err= DB_CORRUPTION;
+        goto func_exit;
+      }
+
+      for (const rec_t *rec= page_rec_get_next_const(page_get_infimum_rec(page));
+           rec && page_rec_is_user_rec(rec);
+           rec= page_rec_get_next_const(rec))
+      {
+        if (child == FIL_NULL)
+        {
+          /* The first node pointer on the level is the minimum
+          record. It does not start a range. */
+          offsets= rec_get_offsets(rec, index, offsets, 0, ULINT_UNDEFINED,
+                                   &heap);
+          child= btr_node_ptr_get_child_page_no(rec, offsets);
+          continue;
+        }
+
+        dtuple_t *tuple= dtuple_create(m_heap, n_uniq);
+        dict_index_copy_types(tuple, index, n_uniq);
+        rec_copy_prefix_to_dtuple(tuple, rec, index, 0, n_uniq, m_heap);
+        tuple->info_bits= 0;
+        bounds.push_back(tuple);
+      }
+
+      const uint32_t next= btr_page_get_next(page);
+      if (next == FIL_NULL)
+        break;
+      b= btr_block_get(*index, next, RW_S_LATCH, false, &mtr, &err);
+      if (!b)
+        goto func_exit;
+    }
+
+    if (bounds.size() + 1 >= target || level == 1)
+      break;
+    if (child == FIL_NULL)
+    {
+      err= DB_CORRUPTION;
+      goto func_exit;
+    }
+
+    block= btr_block_get(*index, child, RW_S_LATCH, false, &mtr, &err);
+    if (!block)
+      goto func_exit;
+  }
+
+  err= DB_SUCCESS;
+
+  if (bounds.empty())
+    /* The root page is a leaf page. */
+    err= DB_UNSUPPORTED;
+  else
+  {
+    /* Pick evenly spaced bounds. */
+    const ulint n_bounds= bounds.size();
+    const ulint n_ranges= std::min(n_bounds + 1, target);
+    const dtuple_t *low= nullptr;
+
+    for (ulint i= 1; i < n_ranges; i++)
+    {
+      const dtuple_t *high= bounds[i * (n_bounds + 1) / n_ranges - 1];
+      m_ranges.push_back(range_t{low, high});
+      low= high;
+    }
+
+    m_ranges.push_back(range_t{low, nullptr});
+  }
+
+func_exit:
+  mtr.commit();
+  if (heap)
+    mem_heap_free(heap);
+  return err;
+}
+
+/** Open the read view, partition the clustered index, and start
+the tasks.
+@retval DB_SUCCESS      if the scan was started
+@retval DB_UNSUPPORTED  if the index is too small to be partitioned
+@return error code */
+dberr_t row_pscan_t::start()
+{
+  trx_t *trx= m_prebuilt->trx;
+
+  ut_ad(is_supported(m_prebuilt));
+  ut_ad(m_tasks.empty());
+
+  if (m_prebuilt->sql_stat_start)
+  {
+    /* Do the start-of-statement preparations of row_search_mvcc(). */
+    m_prebuilt->sql_stat_start= FALSE;
+    trx_start_if_not_started(trx, false);
+    trx->read_view.open(trx);
+  }
+
+  ut_ad(trx->read_view.is_open());
+
+  if (const trx_id_t bulk_trx_id= m_prebuilt->table->bulk_trx_id)
+    /* See row_search_mvcc() for a comment on bulk_trx_id */
+    if (!trx->read_view.changes_visible(bulk_trx_id))
+      return DB_SUCCESS;
+
+  if (dberr_t err= partition())
+    return err;
+
+  /* Any BLOBs of an earlier row must not be referenced any more;
+  row_sel_store_mysql_rec() would free prebuilt->blob_heap. */
+  if (m_prebuilt->blob_heap)
+    row_mysql_prebuilt_free_blob_heap(m_prebuilt);
+
+  m_reserved= reserve_tasks(std::min(m_n_threads, m_ranges.size()));
+  if (m_reserved < 2)
+    return DB_UNSUPPORTED;
+
+  const ulint n_tasks= m_reserved;
+  /* Allow each task to fill a batch while the consumer is reading one. */
+  const ulint n_batches= n_tasks * 2;
+
+  m_buf= static_cast<byte*>(ut_malloc_nokey(n_batches * BATCH_ROWS *
+                                            m_row_size));
+  if (!m_buf)
+    return DB_OUT_OF_MEMORY;
+
+  m_batches.resize(n_batches);
+  for (ulint i= 0; i < n_batches; i++)
+  {
+    m_batches[i]= batch_t{m_buf + i * BATCH_ROWS * m_row_size, 0, 0};
+    m_free.push_back(&m_batches[i]);
+  }
+
+  m_active= n_tasks;
+  for (ulint i= 0; i < n_tasks; i++)
+  {
+    m_tasks.push_back(new tpool::waitable_task(worker_callback, this));
+    srv_thread_pool->submit_task(m_tasks.back());
+  }
+
+  row_pscan_n_scans++;
+  return DB_SUCCESS;
+}
+
+/** Hand over a full batch (if any) and acquire an empty one.
+@param batch  batch to be handed over to the consumer, or nullptr
+@return an empty batch
+@retval nullptr if the scan was aborted */
+row_pscan_t::batch_t *row_pscan_t::exchange(batch_t *batch)
+{
+  std::unique_lock<std::mutex> lk(m_mutex);
+
+  if (batch)
+  {
+    m_full.push_back(batch);
+    m_cond.notify_all();
+  }
+
+  if (m_free.empty() && !m_abort && m_err == DB_SUCCESS)
+  {
+    /* Waiting for the consumer may take arbitrarily long. Let
+    srv_thread_pool run other tasks meanwhile. */
+    tpool::tpool_wait_begin();
+    do
+      m_cond.wait(lk);
+    while (m_free.empty() && !m_abort && m_err == DB_SUCCESS);
+    tpool::tpool_wait_end();
+  }
+
+  if (m_abort || m_err != DB_SUCCESS)
+    return nullptr;
+
+  batch= m_free.back();
+  m_free.pop_back();
+  ut_ad(!batch->n_rows);
+  return batch;
+}
+
+/** Scan a range of the clustered index.
+@param range  the range
+@param batch  batch to fill; nullptr if the scan was aborted
+@return error code */
+dberr_t row_pscan_t::scan_range(const range_t &range, batch_t *&batch)
+{
+  dict_index_t *index= m_prebuilt->index;
+  ReadView &view= m_prebuilt->trx->read_view;
+  const bool comp= index->table->not_redundant();
+  const bool row_id= m_prebuilt->clust_index_was_generated;
+  mem_heap_t *heap= mem_heap_create(srv_page_size);
+  mem_heap_t *vers_heap= nullptr;
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs *offsets= offsets_;
+  rec_offs_init(offsets_);
+  btr_pcur_t pcur;
+  mtr_t mtr;
+  dberr_t err;
+
+  ut_ad(batch);
+
+  mtr.start();
+
+  if (range.low)
+    err= btr_pcur_open_on_user_rec(range.low, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+                                   &pcur, &mtr);
+  else
+  {
+    pcur.btr_cur.page_cur.index= index;
+    err= pcur.open_leaf(true, index, BTR_SEARCH_LEAF, &mtr);
+  }
+
+  if (err != DB_SUCCESS ||
+      (!btr_pcur_is_on_user_rec(&pcur) &&
+       !btr_pcur_move_to_next_user_rec(&pcur, &mtr)))
+    goto func_exit;
+
+  do
+  {
+    if (UNIV_UNLIKELY(m_abort.load(std::memory_order_relaxed)))
+    {
+      err= DB_INTERRUPTED;
+      break;
+    }
+
+    const rec_t *rec= btr_pcur_get_rec(&pcur);
+    offsets= rec_get_offsets(rec, index, offsets, index->n_core_fields,
+                             ULINT_UNDEFINED, &heap);
+
+    if (range.high && cmp_dtuple_rec(range.high, rec, index, offsets) <= 0)
+      break;
+    if (rec_is_metadata(rec, *index))
+      continue;
+
+    switch (err= row_sel_clust_sees(rec, *index, offsets, view)) {
+    case DB_SUCCESS:
+      break;
+    case DB_SUCCESS_LOCKED_REC:
+      rec_t *old_vers;
+      if (!vers_heap)
+        vers_heap= mem_heap_create(srv_page_size);
+      else
+        mem_heap_empty(vers_heap);
+      err= row_vers_build_for_consistent_read(rec, &mtr, index, &offsets,
+                                              &view,
+                                              &heap, vers_heap, &old_vers,
+                                              nullptr);
+      if (err != DB_SUCCESS)
+        goto func_exit;
+      if (!old_vers)
+        /* The row did not exist in the read view. */
+        continue;
+      rec= old_vers;
+      break;
+    default:
+      goto func_exit;
+    }
+
+    if (rec_get_deleted_flag(rec, comp))
+      continue;
+
+    byte *row= batch->rows + batch->n_rows * m_row_size;
+
+    if (!row_sel_store_mysql_rec(row, m_prebuilt, rec, nullptr, false,
+                                 index, offsets))
+      continue;
+
+    if (row_id)
+      /* DB_ROW_ID is the first field of the generated clustered index */
+      memcpy(row + m_prebuilt->mysql_row_len, rec, DATA_ROW_ID_LEN);
+
+    if (++batch->n_rows < BATCH_ROWS)
+      continue;
+
+    /* Release the page latch while waiting for the consumer. */
+    btr_pcur_store_position(&pcur, &mtr);
+    mtr.commit();
+
+    batch= exchange(batch);
+    if (!batch)
+    {
+      err= DB_INTERRUPTED;
+      goto func_exit_committed;
+    }
+
+    mtr.start();
+    if (pcur.restore_position(BTR_SEARCH_LEAF, &mtr) ==
+        btr_pcur_t::CORRUPTED)
+    {
+      err= DB_CORRUPTION;
+      break;
+    }
+  }
+  while (btr_pcur_move_to_next_user_rec(&pcur, &mtr));
+
+func_exit:
+  mtr.commit();
+func_exit_committed:
+  ut_free(pcur.old_rec_buf);
+  if (vers_heap)
+    mem_heap_free(vers_heap);
+  mem_heap_free(heap);
+  return err;
+}
+
+/** Scan the ranges in a srv_thread_pool task */
+void row_pscan_t::worker()
+{
+  dberr_t err= DB_SUCCESS;
+  batch_t *batch= exchange(nullptr);
+
+  while (batch)
+  {
+    const ulint i= m_next_range.fetch_add(1, std::memory_order_relaxed);
+    if (i >= m_ranges.size())
+      break;
+    err= scan_range(m_ranges[i], batch);
+    if (err != DB_SUCCESS)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (!batch);
+  else if (batch->n_rows && err == DB_SUCCESS)
+    m_full.push_back(batch);
+  else
+  {
+    batch->n_rows= 0;
+    m_free.push_back(batch);
+  }
+
+  if (err != DB_SUCCESS && err != DB_INTERRUPTED && m_err == DB_SUCCESS)
+    m_err= err;
+  ut_ad(m_active);
+  m_active--;
+  m_cond.notify_all();
+}
+
+/** Fetch the next row.
+@param buf  row buffer in the MySQL format
+@retval DB_SUCCESS       if a row was fetched
+@retval DB_END_OF_INDEX  if all rows have been fetched
+@return error code */
+dberr_t row_pscan_t::fetch(byte *buf)
+{
+  for (;;)
+  {
+    if (batch_t *batch= m_current)
+    {
+      if (batch->n_fetched < batch->n_rows)
+      {
+        const byte *row= batch->rows + batch->n_fetched++ * m_row_size;
+        memcpy(buf, row, m_prebuilt->mysql_prefix_len);
+        if (m_prebuilt->clust_index_was_generated)
+          memcpy(m_prebuilt->row_id, row + m_prebuilt->mysql_row_len,
+                 DATA_ROW_ID_LEN);
+        return DB_SUCCESS;
+      }
+    }
+
+    std::unique_lock<std::mutex> lk(m_mutex);
+
+    if (batch_t *batch= m_current)
+    {
+      batch->n_rows= batch->n_fetched= 0;
+      m_free.push_back(batch);
+      m_current= nullptr;
+      m_cond.notify_all();
+    }
+
+    while (m_full.empty() && m_active && m_err == DB_SUCCESS)
+      m_cond.wait(lk);
+
+    if (m_err != DB_SUCCESS)
+      return m_err;
+    if (m_full.empty())
+      return DB_END_OF_INDEX;
+
+    m_current= m_full.back();
+    m_full.pop_back();
+  }
+}
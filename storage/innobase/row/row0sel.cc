@@ -956,9 +956,8 @@ row_sel_test_other_conds(
 @retval DB_SUCCESS             if rec is visible in view
 @retval DB_SUCCESS_LOCKED_REC  if rec is not visible in view
 @retval DB_CORRUPTION          if the DB_TRX_ID is corrupted */
-static dberr_t row_sel_clust_sees(const rec_t *rec, const dict_index_t &index,
-                                  const rec_offs *offsets,
-                                  const ReadView &view)
+dberr_t row_sel_clust_sees(const rec_t *rec, const dict_index_t &index,
+                           const rec_offs *offsets, const ReadView &view)
 {
   ut_ad(index.is_primary());
   ut_ad(page_rec_is_user_rec(rec));
@@ -3129,8 +3128,7 @@ be needed in the query.
 @param[in]	offsets		array returned by rec_get_offsets(rec)
 @retval true on success
 @retval false if not all columns could be retrieved */
-MY_ATTRIBUTE((warn_unused_result))
-static bool row_sel_store_mysql_rec(
+bool row_sel_store_mysql_rec(
 	byte*		mysql_rec,
 	row_prebuilt_t*	prebuilt,
 	const rec_t*	rec,
@@ -44,6 +44,7 @@ Created 10/8/1995 Heikki Tuuri
 #include "mysql/psi/psi.h"
 
 #include "btr0sea.h"
+#include "buf0dump.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
 #include "dict0boot.h"
@@ -132,6 +133,8 @@ my_bool	high_level_read_only;
 
 /** Sort buffer size in index creation */
 ulong	srv_sort_buf_size;
+/** innodb_sort_threads */
+ulong	srv_sort_threads;
 /** Maximum modification log file size for online index creation */
 unsigned long long	srv_online_max_size;
 
@@ -141,6 +144,7 @@ use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 my_bool	srv_use_native_aio;
 my_bool	srv_numa_interleave;
+my_bool	srv_numa_local;
 /** copy of innodb_use_atomic_writes; @see innodb_init_params() */
 my_bool	srv_use_atomic_writes;
 /** innodb_compression_algorithm; used with page compression */
@@ -197,6 +201,8 @@ ulint	srv_buf_pool_base_size;
 ulint	srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 ulong	srv_buf_pool_dump_pct;
+/** innodb_buffer_pool_dump_interval, in seconds; 0=disabled */
+ulong	srv_buf_pool_dump_interval;
 /** Abort load after this amount of pages */
 #ifdef UNIV_DEBUG
 ulong srv_buf_pool_load_pages_abort = LONG_MAX;
@@ -218,6 +224,9 @@ my_bool	srv_random_read_ahead;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong	srv_read_ahead_threshold;
+/** innodb_read_ahead_pages; the number of leaf pages to read ahead
+when a cursor scans an index in a regular pattern */
+ulong	srv_read_ahead_pages;
 
 /** innodb_change_buffer_max_size; maximum on-disk size of change
 buffer in terms of percentage of the buffer pool. */
@@ -1024,8 +1033,12 @@ srv_export_innodb_status(void)
 	export_vars.innodb_defragment_count = btr_defragment_count;
 
 	export_vars.innodb_onlineddl_rowlog_rows = onlineddl_rowlog_rows;
+	export_vars.innodb_onlineddl_rowlog_applied = onlineddl_rowlog_applied;
 	export_vars.innodb_onlineddl_rowlog_pct_used = onlineddl_rowlog_pct_used;
 	export_vars.innodb_onlineddl_pct_progress = onlineddl_pct_progress;
+	export_vars.innodb_onlineddl_sort_tasks = onlineddl_sort_tasks;
+	export_vars.innodb_onlineddl_rowlog_applied_in_sort =
+		onlineddl_rowlog_applied_in_sort;
 
 	if (!srv_read_only_mode) {
 		export_vars.innodb_encryption_rotation_pages_read_from_cache =
@@ -1451,6 +1464,8 @@ void srv_master_callback(void*)
   else
     srv_master_do_idle_tasks(counter_time);
 
+  buf_dump_at_interval(counter_time);
+
   srv_main_thread_op_info= "sleeping";
 }
 
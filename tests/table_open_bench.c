@@ -0,0 +1,283 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Measure the number of table opens per second with 1, 2, 4, ...
+  --max-threads concurrent connections.
+
+  Every statement is a SELECT from one of --tables tables, so that it
+  goes through the table definition cache, the table cache and the
+  metadata locks without reading any rows.
+*/
+
+#include <my_global.h>
+
+#include <my_sys.h>
+#include <my_pthread.h>
+#include "mysql.h"
+#include <my_getopt.h>
+
+static my_bool tty_password= 0, keep_tables= 0;
+static uint number_of_tables= 1000, max_threads= 256, seconds= 5;
+static char *database, *host, *user, *password, *unix_socket;
+static uint tcp_port;
+
+static volatile int stop;
+
+struct bench_thread
+{
+  pthread_t tid;
+  MYSQL *mysql;
+  uint id;
+  ulonglong queries;
+  my_bool failed;
+};
+
+
+static MYSQL *bench_connect()
+{
+  MYSQL *mysql= mysql_init(NULL);
+  if (!mysql_real_connect(mysql, host, user, password, database, tcp_port,
+                          unix_socket, 0))
+  {
+    fprintf(stderr, "Couldn't connect to server: %s\n", mysql_error(mysql));
+    mysql_close(mysql);
+    return NULL;
+  }
+  return mysql;
+}
+
+
+static int bench_query(MYSQL *mysql, const char *query)
+{
+  MYSQL_RES *res;
+  if (mysql_query(mysql, query))
+  {
+    fprintf(stderr, "Query '%s' failed: %s\n", query, mysql_error(mysql));
+    return 1;
+  }
+  if ((res= mysql_store_result(mysql)))
+    mysql_free_result(res);
+  return 0;
+}
+
+
+static void *bench_thread_func(void *arg)
+{
+  struct bench_thread *thread= (struct bench_thread*) arg;
+  uint table= thread->id * 7919;
+  char query[64];
+
+  while (!stop)
+  {
+    sprintf(query, "SELECT a FROM bench_t%u LIMIT 0",
+            table++ % number_of_tables);
+    if (bench_query(thread->mysql, query))
+    {
+      thread->failed= 1;
+      break;
+    }
+    thread->queries++;
+  }
+  return 0;
+}
+
+
+/* Run one step with n threads. @return opens per second, or -1 on error */
+
+static double bench_run(struct bench_thread *threads, uint n)
+{
+  ulonglong start, end, queries= 0;
+  my_bool failed= 0;
+  uint i;
+
+  stop= 0;
+  for (i= 0; i < n; i++)
+  {
+    threads[i].queries= 0;
+    threads[i].failed= 0;
+    if (pthread_create(&threads[i].tid, NULL, bench_thread_func, threads + i))
+    {
+      fprintf(stderr, "Couldn't create thread %u (errno: %d)\n", i, errno);
+      stop= 1;
+      n= i;
+      failed= 1;
+      break;
+    }
+  }
+  start= my_interval_timer();
+  if (!failed)
+    sleep(seconds);
+  stop= 1;
+  for (i= 0; i < n; i++)
+  {
+    pthread_join(threads[i].tid, NULL);
+    queries+= threads[i].queries;
+    failed|= threads[i].failed;
+  }
+  end= my_interval_timer();
+  return failed ? -1 : queries * 1e9 / (double) (end - start);
+}
+
+
+static struct my_option my_long_options[] =
+{
+  {"help", '?', "Display this help and exit", 0, 0, 0, GET_NO_ARG, NO_ARG, 0,
+   0, 0, 0, 0, 0},
+  {"database", 'D', "Database to use (default test)", &database, &database,
+   0, GET_STR_ALLOC, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"host", 'h', "Connect to host", &host, &host, 0, GET_STR,
+   REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"keep-tables", 'k', "Do not drop the tables in the end", &keep_tables,
+   &keep_tables, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+  {"max-threads", 't', "Number of threads in the last step",
+   &max_threads, &max_threads, 0, GET_UINT, REQUIRED_ARG, 256, 1, 65536,
+   0, 0, 0},
+  {"password", 'p',
+   "Password to use when connecting to server. If password is not given it's asked from the tty.",
+   0, 0, 0, GET_STR, OPT_ARG, 0, 0, 0, 0, 0, 0},
+  {"port", 'P', "Port number to use for connection", &tcp_port,
+   &tcp_port, 0, GET_UINT, REQUIRED_ARG, MYSQL_PORT, 0, 0, 0, 0, 0},
+  {"seconds", 's', "Duration of each step", &seconds, &seconds, 0,
+   GET_UINT, REQUIRED_ARG, 5, 1, 3600, 0, 0, 0},
+  {"socket", 'S', "Socket file to use for connection", &unix_socket,
+   &unix_socket, 0, GET_STR_ALLOC, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  {"tables", 'n', "Number of tables to create and open",
+   &number_of_tables, &number_of_tables, 0, GET_UINT, REQUIRED_ARG, 1000, 1,
+   1000000, 0, 0, 0},
+  {"user", 'u', "User for login if not current user", &user,
+   &user, 0, GET_STR_ALLOC, REQUIRED_ARG, 0, 0, 0, 0, 0, 0},
+  { 0, 0, 0, 0, 0, 0, GET_NO_ARG, NO_ARG, 0, 0, 0, 0, 0, 0}
+};
+
+
+static const char *load_default_groups[]=
+{ "client", "client-server", "client-mariadb", 0 };
+
+static void usage()
+{
+  printf("Measure table opens per second with concurrent connections\n");
+  printf("Usage: %s [OPTIONS]\n", my_progname);
+  my_print_help(my_long_options);
+  print_defaults("my", load_default_groups);
+  my_print_variables(my_long_options);
+}
+
+
+static my_bool
+get_one_option(const struct my_option *opt,
+               const char *argument,
+               const char *filename __attribute__((unused)))
+{
+  switch (opt->id) {
+  case 'p':
+    if (argument)
+    {
+      char *start= (char*) argument;
+      my_free(password);
+      password= my_strdup(PSI_NOT_INSTRUMENTED, argument, MYF(MY_FAE));
+      while (*argument) *(char*) argument++= 'x';     /* Destroy argument */
+      if (*start)
+        start[1]= 0;
+    }
+    else
+      tty_password= 1;
+    break;
+  case '?':
+    usage();
+    exit(0);
+  }
+  return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+  struct bench_thread *threads;
+  char **defaults_argv;
+  MYSQL *mysql;
+  char query[128];
+  uint i, n;
+  int error= 0;
+
+  MY_INIT(argv[0]);
+  load_defaults_or_exit("my", load_default_groups, &argc, &argv);
+  defaults_argv= argv;
+  if ((error= handle_options(&argc, &argv, my_long_options, get_one_option)))
+    exit(error);
+  if (tty_password)
+    password= get_tty_password(NullS);
+  if (!database)
+    database= my_strdup(PSI_NOT_INSTRUMENTED, "test", MYF(MY_FAE));
+
+  if (!(mysql= bench_connect()))
+    exit(1);
+
+  printf("Creating %u tables\n", number_of_tables);
+  for (i= 0; i < number_of_tables; i++)
+  {
+    sprintf(query, "CREATE TABLE IF NOT EXISTS bench_t%u (a INT)", i);
+    if (bench_query(mysql, query))
+      exit(1);
+  }
+
+  if (!(threads= (struct bench_thread*)
+        my_malloc(PSI_NOT_INSTRUMENTED, max_threads * sizeof *threads,
+                  MYF(MY_WME | MY_ZEROFILL))))
+    exit(1);
+
+  printf("threads\topens/s\n");
+  for (n= 1, i= 0; ; n= MY_MIN(n * 2, max_threads))
+  {
+    double rate;
+    /* The connections of the previous steps are reused */
+    for (; i < n; i++)
+    {
+      threads[i].id= i;
+      if (!(threads[i].mysql= bench_connect()))
+      {
+        error= 1;
+        goto end;
+      }
+    }
+    if ((rate= bench_run(threads, n)) < 0)
+    {
+      error= 1;
+      goto end;
+    }
+    printf("%u\t%.0f\n", n, rate);
+    fflush(stdout);
+    if (n == max_threads)
+      break;
+  }
+
+end:
+  while (i--)
+    mysql_close(threads[i].mysql);
+  my_free(threads);
+
+  if (!keep_tables)
+  {
+    for (i= 0; i < number_of_tables; i++)
+    {
+      sprintf(query, "DROP TABLE IF EXISTS bench_t%u", i);
+      bench_query(mysql, query);
+    }
+  }
+  mysql_close(mysql);
+  free_defaults(defaults_argv);
+  my_end(0);
+  return error;
+}